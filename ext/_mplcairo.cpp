@@ -10,6 +10,8 @@
 
 #include <pybind11/native_enum.h>
 
+#include <cerrno>
+#include <cstring>
 #include <stack>
 #include <thread>
 
@@ -53,6 +55,139 @@ py::bytes Region::get_straight_argb32_bytes()
   return py::bytes{static_cast<char const*>(buf.ptr), size};
 }
 
+StreamWriter::StreamWriter(py::object file) :
+  file_{file}, capacity_{detail::STREAM_BUFFER_SIZE}
+{
+  auto const& io = py::module::import("io");
+  auto const& cls = file.attr("__class__");
+  if ((cls.is(io.attr("FileIO")) || cls.is(io.attr("BufferedWriter")))
+      && file.attr("seekable")().cast<bool>()) {
+    file.attr("flush")();
+    fd_ = file.attr("fileno")().cast<int>();
+  } else {
+    write_ = file.attr("write");
+  }
+  buffer_.reserve(capacity_);
+}
+
+StreamWriter::~StreamWriter()
+{
+  // Normally, everything has already been flushed by _finish().
+  [[maybe_unused]] auto const& gil = py::gil_scoped_acquire{};
+  try {
+    // If the file has been closed, its fd may have been reused.
+    if (fd_ < 0 || !file_.attr("closed").cast<bool>()) {
+      flush();
+    }
+  } catch (py::error_already_set const& e) {
+    // Cannot propagate out of cairo's user data destructors; see ~GCR.
+#ifdef _WIN32
+    std::cerr << std::flush;
+#endif
+    std::cerr << "Exception ignored in destructor: " << e.what() << "\n";
+  }
+  write_ = {};
+  file_ = {};
+}
+
+bool StreamWriter::failed() const
+{
+  return errno_ || exception_ || short_write_;
+}
+
+bool StreamWriter::write_through(unsigned char const* data, size_t length)
+{
+  if (failed()) {
+    return false;
+  }
+  if (fd_ >= 0) {
+    if (!os::write_all(fd_, data, length)) {
+      errno_ = errno ? errno : EIO;
+      return false;
+    }
+    return true;
+  }
+  // Drawing and finishing may release the GIL, and some surfaces (e.g. script
+  // surfaces) write as they draw.
+  [[maybe_unused]] auto const& gil = py::gil_scoped_acquire{};
+  try {
+    if (write_(py::memoryview::from_memory(data, length)).cast<size_t>()
+        != length) {
+      short_write_ = true;
+      return false;
+    }
+  } catch (py::error_already_set& e) {
+    // Don't propagate exceptions through cairo.
+    exception_ = std::move(e);
+    return false;
+  }
+  return true;
+}
+
+cairo_status_t StreamWriter::write(
+  void* closure, unsigned char const* data, unsigned int length)
+{
+  auto& writer = *static_cast<StreamWriter*>(closure);
+  writer.n_written_ += length;
+  if (writer.buffer_.size() + length > writer.capacity_) {
+    if (!writer.flush()) {
+      return CAIRO_STATUS_WRITE_ERROR;
+    }
+    if (length >= writer.capacity_) {
+      return  // NOTE: This does not appear to affect the context status.
+        writer.write_through(data, length)
+        ? CAIRO_STATUS_SUCCESS : CAIRO_STATUS_WRITE_ERROR;
+    }
+  }
+  writer.buffer_.insert(writer.buffer_.end(), data, data + length);
+  return CAIRO_STATUS_SUCCESS;
+}
+
+StreamWriter* StreamWriter::get(cairo_surface_t* surface)
+{
+  if (auto const& writer =
+        cairo_surface_get_user_data(surface, &detail::STREAM_WRITER_KEY)) {
+    return static_cast<StreamWriter*>(writer);
+  }
+  if (auto const& device = cairo_surface_get_device(surface)) {
+    return static_cast<StreamWriter*>(
+      cairo_device_get_user_data(device, &detail::STREAM_WRITER_KEY));
+  }
+  return nullptr;
+}
+
+bool StreamWriter::flush()
+{
+  if (buffer_.empty()) {
+    return true;
+  }
+  auto const& ok = write_through(buffer_.data(), buffer_.size());
+  buffer_.clear();
+  return ok;
+}
+
+void StreamWriter::sync()
+{
+  flush();
+  if (errno_) {
+    PyErr_SetObject(
+      PyExc_OSError, py::make_tuple(errno_, std::strerror(errno_)).ptr());
+    throw py::error_already_set{};
+  } else if (exception_) {
+    throw *exception_;
+  } else if (short_write_) {
+    throw std::runtime_error{"short write to output stream"};
+  }
+  if (fd_ >= 0) {
+    file_.attr("seek")(0, 1);  // BufferedWriter caches the position.
+  }
+}
+
+size_t StreamWriter::n_written() const
+{
+  return n_written_;
+}
+
 py::object renderer_base(std::string meth_name)
 {
   return
@@ -92,12 +227,15 @@ GraphicsContextRenderer::AdditionalContext::AdditionalContext(
     }
   }, state.antialias);
   // Clip, if needed.  Cannot be done earlier as we need to be able to unclip.
-  if (auto const& rectangle = state.clip_rectangle) {
-    auto const& [x, y, w, h] = rectangle->attr("bounds").cast<rectangle_t>();
+  // The rectangle bounds are converted to device space by set_clip_rectangle.
+  if (auto const& [py_rectangle, rectangle] = state.clip_rectangle;
+      rectangle) {
+    (void)py_rectangle;
+    auto const& [x, y, w, h] = *rectangle;
     cairo_save(cr);
     restore_init_matrix(cr);
     cairo_new_path(cr);
-    cairo_rectangle(cr, x, gcr->height_ - h - y, w, h);
+    cairo_rectangle(cr, x, y, w, h);
     cairo_restore(cr);
     cairo_clip(cr);
   }
@@ -127,6 +265,59 @@ GraphicsContextRenderer::AdditionalContext::~AdditionalContext()
   cairo_restore(gcr_->cr_);
 }
 
+// Hatch patterns are cached on the cairo_t, as hatched artists (e.g. bars)
+// typically share the same hatch.  Returns nullptr if there is no hatch.
+cairo_pattern_t* GraphicsContextRenderer::get_hatch_pattern()
+{
+  auto& state = get_additional_state();
+  if (!state.hatch) {
+    return nullptr;
+  }
+  auto cache = static_cast<HatchCache*>(
+    cairo_get_user_data(cr_, &detail::HATCH_CACHE_KEY));
+  if (!cache) {
+    cache = new HatchCache{};
+    CAIRO_CHECK_SET_USER_DATA(
+      cairo_set_user_data, cr_, &detail::HATCH_CACHE_KEY,
+      cache, [](void* ptr) { delete static_cast<HatchCache*>(ptr); });
+  }
+  auto const& dpi = int(dpi_);  // Truncating is good enough.
+  auto const& hatch_color = state.get_hatch_color();
+  auto const& key = std::tuple{
+    *state.hatch, hatch_color, state.get_hatch_linewidth(), dpi};
+  if (auto const& it = cache->patterns.find(key);
+      it != cache->patterns.end()) {
+    return it->second.get();
+  }
+  auto hatch_pattern =
+    std::unique_ptr<cairo_pattern_t, decltype(&cairo_pattern_destroy)>{
+      nullptr, cairo_pattern_destroy};
+  if (auto const& hatch_path =
+        py::cast(this).attr("get_hatch_path")()
+        .cast<std::optional<py::object>>()) {
+    auto const& hatch_surface =
+      cairo_surface_create_similar(
+        cairo_get_target(cr_), CAIRO_CONTENT_COLOR_ALPHA, dpi, dpi);
+    auto const& hatch_cr = cairo_create(hatch_surface);
+    cairo_surface_destroy(hatch_surface);
+    auto hatch_gcr = GraphicsContextRenderer{
+      hatch_cr, double(dpi), double(dpi), double(dpi)};
+    hatch_gcr.get_additional_state().snap = false;
+    hatch_gcr.set_linewidth(state.get_hatch_linewidth());
+    auto const& mtx =
+      cairo_matrix_t{double(dpi), 0, 0, -double(dpi), 0, double(dpi)};
+    fill_and_stroke_exact(
+      hatch_cr, *hatch_path, &mtx, hatch_color, hatch_color);
+    hatch_pattern.reset(cairo_pattern_create_for_surface(hatch_surface));
+    cairo_pattern_set_extend(hatch_pattern.get(), CAIRO_EXTEND_REPEAT);
+  }
+  if (cache->patterns.size() >= 64) {  // NOTE: Arbitrary limit.
+    cache->patterns.clear();
+  }
+  return
+    cache->patterns.emplace(key, std::move(hatch_pattern)).first->second.get();
+}
+
 double GraphicsContextRenderer::pixels_to_points(double pixels)
 {
   return pixels / (dpi_ / 72);
@@ -183,12 +374,16 @@ GraphicsContextRenderer::GraphicsContextRenderer(
 
 GraphicsContextRenderer::~GraphicsContextRenderer()
 {
-  if (detail::FONT_CACHE.size() > 64) {  // font_manager._get_font cache size.
-    for (auto& [pathspec, face]: detail::FONT_CACHE) {
-      (void)pathspec;
-      cairo_font_face_destroy(face);
+  auto evicted = decltype(detail::FONT_CACHE){};
+  {
+    auto const& lock = std::lock_guard{detail::FONT_CACHE_MUTEX};
+    if (detail::FONT_CACHE.size() > 64) {  // font_manager._get_font cache size.
+      evicted.swap(detail::FONT_CACHE);  // Naive cache mechanism.
     }
-    detail::FONT_CACHE.clear();  // Naive cache mechanism.
+  }
+  for (auto& [pathspec, face]: evicted) {
+    (void)pathspec;
+    cairo_font_face_destroy(face);  // Outside of the lock.
   }
   try {
 #ifdef _WIN32
@@ -267,6 +462,15 @@ cairo_t* GraphicsContextRenderer::cr_from_fileformat_args(
   StreamSurfaceType type, py::object file,
   double width, double height, double dpi)
 {
+  if (type == StreamSurfaceType::Recording) {
+    // Not written anywhere, but replayed onto other renderers (and thus file
+    // is ignored); see _replay_onto.
+    auto const& extents = cairo_rectangle_t{0, 0, width, height};
+    return cr_from_stream_surface(
+      type,
+      cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &extents),
+      dpi);
+  }
   auto surface_create_for_stream =
     [&]() -> cairo_surface_t* (*)(cairo_write_func_t, void*, double, double) {
       switch (type) {
@@ -298,30 +502,29 @@ cairo_t* GraphicsContextRenderer::cr_from_fileformat_args(
       "cairo was built without {.name} support"_format(type)
       .cast<std::string>()};
   }
-  auto const& cb =
-    [](void* closure, unsigned char const* data, unsigned int length)
-        -> cairo_status_t {
-      auto const& write =
-        py::reinterpret_borrow<py::object>(static_cast<PyObject*>(closure));
-      auto const& written =
-        write(py::memoryview::from_memory(data, length)).cast<unsigned int>();
-      return  // NOTE: This does not appear to affect the context status.
-        written == length ? CAIRO_STATUS_SUCCESS : CAIRO_STATUS_WRITE_ERROR;
-    };
-  auto const& write = file.attr("write");
+  auto const& writer = new StreamWriter{file};
   auto const& surface =
-    surface_create_for_stream(cb, write.ptr(), width, height);
-  cairo_surface_set_fallback_resolution(surface, dpi, dpi);
-  auto const& cr = cairo_create(surface);
-  cairo_surface_destroy(surface);
-  CAIRO_CHECK_SET_USER_DATA_NEW(
-    cairo_set_user_data, cr, &detail::REFS_KEY,
-    std::vector<py::object>{{write}});
-  if (type == StreamSurfaceType::EPS) {
-    // If cairo was built without PS support, we'd already have errored above.
-    detail::cairo_ps_surface_set_eps(surface, true);
+    surface_create_for_stream(StreamWriter::write, writer, width, height);
+  auto const& writer_deleter =
+    [](void* ptr) { delete static_cast<StreamWriter*>(ptr); };
+  if (auto const& status = cairo_surface_status(surface);
+      status != CAIRO_STATUS_SUCCESS) {
+    delete writer;
+    THROW_ERROR(
+      "cairo_surface_create_for_stream", cairo_status_to_string(status));
+  }
+  if (type == StreamSurfaceType::Script) {
+    // The script device writes (and must outlive the writer) beyond the
+    // surface's user data, which gets destroyed first.
+    CAIRO_CHECK_SET_USER_DATA(
+      cairo_device_set_user_data, cairo_surface_get_device(surface),
+      &detail::STREAM_WRITER_KEY, writer, writer_deleter);
+  } else {
+    CAIRO_CHECK_SET_USER_DATA(
+      cairo_surface_set_user_data, surface, &detail::STREAM_WRITER_KEY,
+      writer, writer_deleter);
   }
-  return cr;
+  return cr_from_stream_surface(type, surface, dpi);
 }
 
 GraphicsContextRenderer::GraphicsContextRenderer(
@@ -334,6 +537,91 @@ GraphicsContextRenderer::GraphicsContextRenderer(
       ? dpi : 72}
 {}
 
+cairo_t* GraphicsContextRenderer::cr_from_fileformat_args(
+  StreamSurfaceType type, std::string filename,
+  double width, double height, double dpi)
+{
+  auto surface_create =
+    [&]() -> cairo_surface_t* (*)(char const*, double, double) {
+      switch (type) {
+        case StreamSurfaceType::PDF:
+          return detail::cairo_pdf_surface_create;
+        case StreamSurfaceType::PS:
+        case StreamSurfaceType::EPS:
+          return detail::cairo_ps_surface_create;
+        case StreamSurfaceType::SVG:
+          return detail::cairo_svg_surface_create;
+        case StreamSurfaceType::Script:
+          return
+            [](char const* filename,
+               double width, double height) -> cairo_surface_t* {
+              auto const& script = cairo_script_create(filename);
+              auto const& surface =
+                cairo_script_surface_create(
+                  script, CAIRO_CONTENT_COLOR_ALPHA, width, height);
+              cairo_device_destroy(script);
+              return surface;
+            };
+        default:
+          return nullptr;
+      }
+    }();
+  if (!surface_create) {
+    throw std::runtime_error{
+      "cairo was built without {.name} support"_format(type)
+      .cast<std::string>()};
+  }
+  // cairo writes the file itself (via stdio), without going through Python.
+  // Failing to open the file sets errno, which is saved right away as
+  // reacquiring the GIL may clobber it.
+  auto err = 0;
+  auto const& surface = [&] {
+    [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+    errno = 0;
+    auto const& surface = surface_create(filename.c_str(), width, height);
+    err = errno;
+    return surface;
+  }();
+  if (auto const& status = cairo_surface_status(surface);
+      status != CAIRO_STATUS_SUCCESS) {
+    if (status == CAIRO_STATUS_WRITE_ERROR && err) {
+      // Report the actual OSError (missing directory, etc.).
+      PyErr_SetObject(
+        PyExc_OSError,
+        py::make_tuple(
+          err, std::strerror(err),
+          py::module::import("os").attr("fsdecode")(py::bytes(filename)))
+        .ptr());
+      throw py::error_already_set{};
+    }
+    THROW_ERROR("cairo_surface_create", cairo_status_to_string(status));
+  }
+  return cr_from_stream_surface(type, surface, dpi);
+}
+
+GraphicsContextRenderer::GraphicsContextRenderer(
+  StreamSurfaceType type, std::string filename,
+  double width, double height, double dpi) :
+  GraphicsContextRenderer{
+    cr_from_fileformat_args(type, filename, width, height, dpi), width, height,
+    type == StreamSurfaceType::Script
+      && detail::MPLCAIRO_SCRIPT_SURFACE == detail::MplcairoScriptSurface::Raster
+      ? dpi : 72}
+{}
+
+cairo_t* GraphicsContextRenderer::cr_from_stream_surface(
+  StreamSurfaceType type, cairo_surface_t* surface, double dpi)
+{
+  cairo_surface_set_fallback_resolution(surface, dpi, dpi);
+  auto const& cr = cairo_create(surface);
+  cairo_surface_destroy(surface);
+  if (type == StreamSurfaceType::EPS) {
+    // If cairo was built without PS support, we'd already have errored above.
+    detail::cairo_ps_surface_set_eps(surface, true);
+  }
+  return cr;
+}
+
 GraphicsContextRenderer GraphicsContextRenderer::make_pattern_gcr(
   cairo_surface_t* surface)
 {
@@ -540,6 +828,43 @@ void GraphicsContextRenderer::_show_page()
   cairo_show_page(cr_);
 }
 
+size_t GraphicsContextRenderer::_flush_output()
+{
+  // Write out everything emitted so far by cairo (e.g., completed pages), and
+  // return the total number of bytes written.
+  auto const& surface = cairo_get_target(cr_);
+  cairo_surface_flush(surface);
+  if (auto const& writer = StreamWriter::get(surface)) {
+    writer->sync();
+    return writer->n_written();
+  }
+  return 0;
+}
+
+void GraphicsContextRenderer::_replay_onto(GraphicsContextRenderer& target)
+{
+  auto const& surface = cairo_get_target(cr_);
+  if (auto const& type = cairo_surface_get_type(surface);
+      type != CAIRO_SURFACE_TYPE_RECORDING) {
+    throw std::invalid_argument{
+      "_replay_onto only supports recording surfaces, not {.name}"_format(type)
+      .cast<std::string>()};
+  }
+  auto const& cr = target.cr_;
+  cairo_save(cr);
+  restore_init_matrix(cr);
+  // Recordings are made at 72 dpi; scale them to the target's size.
+  cairo_scale(cr, target.width_ / width_, target.height_ / height_);
+  cairo_set_source_surface(cr, surface, 0, 0);
+  {
+    // Vector targets keep the recording as is (e.g., as a PDF Form XObject);
+    // raster targets replay it at their own resolution.
+    [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+    cairo_paint(cr);
+  }
+  cairo_restore(cr);
+}
+
 py::object GraphicsContextRenderer::_get_context()
 {
   if (detail::has_pycairo) {
@@ -556,9 +881,20 @@ py::array GraphicsContextRenderer::_get_buffer()
   return image_surface_to_buffer(cairo_get_target(cr_));
 }
 
-void GraphicsContextRenderer::_finish()
+size_t GraphicsContextRenderer::_finish()
 {
-  cairo_surface_finish(cairo_get_target(cr_));
+  // Return the total number of bytes written, as _flush_output.
+  auto const& surface = cairo_get_target(cr_);
+  {
+    // Writing through Python (if needed) reacquires the GIL.
+    [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+    cairo_surface_finish(surface);
+  }
+  if (auto const& writer = StreamWriter::get(surface)) {
+    writer->sync();
+    return writer->n_written();
+  }
+  return 0;
 }
 
 void GraphicsContextRenderer::set_alpha(std::optional<double> alpha)
@@ -588,7 +924,13 @@ void GraphicsContextRenderer::set_capstyle(std::string capstyle)
 void GraphicsContextRenderer::set_clip_rectangle(
   std::optional<py::object> rectangle)
 {
-  get_additional_state().clip_rectangle = rectangle;
+  if (rectangle) {
+    auto const& [x, y, w, h] = rectangle->attr("bounds").cast<rectangle_t>();
+    get_additional_state().clip_rectangle =
+      {rectangle, rectangle_t{x, height_ - h - y, w, h}};
+  } else {
+    get_additional_state().clip_rectangle = {{}, {}};
+  }
 }
 
 void GraphicsContextRenderer::set_clip_path(
@@ -752,6 +1094,132 @@ double GraphicsContextRenderer::points_to_pixels(double points)
   return points * dpi_ / 72;
 }
 
+template<typename T>
+void maybe_multithread(
+  cairo_t* cr, double width, double height, int n, T /* lambda */ worker)
+{
+  if (detail::COLLECTION_THREADS) {
+    auto const& chunk_size =
+      int(std::ceil(double(n) / detail::COLLECTION_THREADS));
+    auto ctxs = std::vector<cairo_t*>{};
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0; i < detail::COLLECTION_THREADS; ++i) {
+      auto const& surface =
+        cairo_surface_create_similar_image(
+          cairo_get_target(cr), detail::IMAGE_FORMAT, width, height);
+      auto const& ctx = cairo_create(surface);
+      cairo_surface_destroy(surface);
+      ctxs.push_back(ctx);
+      threads.emplace_back(
+        worker, ctx, chunk_size * i, std::min<int>(chunk_size * (i + 1), n));
+    }
+    {
+      [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+      for (auto& thread: threads) {
+        thread.join();
+      }
+    }
+    for (auto const& ctx: ctxs) {
+      auto const& pattern =
+        cairo_pattern_create_for_surface(cairo_get_target(ctx));
+      cairo_destroy(ctx);
+      cairo_set_source(cr, pattern);
+      cairo_pattern_destroy(pattern);
+      cairo_paint(cr);
+    }
+  }
+  else {
+    worker(cr, 0, n);
+  }
+}
+
+// Paint a mesh pattern made of n patches, which are added by calling
+// add_patch(pattern, k) and whose vertical extents (in the user space of cr)
+// are given by extent(k) (as a (min, max) pair).  Cairo rasterizes mesh
+// patterns on a single thread, so if collection_threads is set, the canvas is
+// instead split into horizontal bands (one per thread).  The patches are
+// bucketed by band once, up front; each band is then rendered, from a pattern
+// made only of the patches intersecting it, onto its own band-sized surface,
+// which is finally composited onto the band.  The callables are called without
+// the GIL, possibly from multiple threads.
+template<typename E, typename P>
+void paint_mesh(
+  cairo_t* cr, double width, double height, int n,
+  cairo_matrix_t const* pattern_matrix, E extent, P add_patch)
+{
+  if (!detail::COLLECTION_THREADS || has_vector_surface(cr)) {
+    [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+    auto const& pattern = cairo_pattern_create_mesh();
+    for (auto k = 0; k < n; ++k) {
+      add_patch(pattern, k);
+    }
+    cairo_pattern_set_matrix(pattern, pattern_matrix);
+    cairo_set_source(cr, pattern);
+    cairo_pattern_destroy(pattern);
+    cairo_paint(cr);
+    return;
+  }
+  auto const& n_bands = detail::COLLECTION_THREADS;
+  // Integer band heights, so that the bands are pixel-aligned.
+  auto const& band_height = std::ceil(height / n_bands);
+  auto buckets = std::vector<std::vector<int>>(n_bands);
+  auto surfaces = std::vector<cairo_surface_t*>(n_bands);
+  {
+    [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+    for (auto k = 0; k < n; ++k) {
+      auto const& [y_min, y_max] = extent(k);
+      if (!(y_min <= height && y_max >= 0)) {  // Also skips NaNs.
+        continue;
+      }
+      auto const& b_min = int(std::max(0., std::floor(y_min / band_height))),
+                & b_max =
+                  int(std::min(n_bands - 1., std::floor(y_max / band_height)));
+      for (auto b = b_min; b <= b_max; ++b) {
+        buckets[b].push_back(k);
+      }
+    }
+    auto threads = std::vector<std::thread>{};
+    for (auto b = 0; b < n_bands; ++b) {
+      auto const& y0 = b * band_height,
+                & y1 = std::min(height, y0 + band_height);
+      if (y0 >= y1 || buckets[b].empty()) {
+        continue;
+      }
+      surfaces[b] =
+        cairo_surface_create_similar_image(
+          cairo_get_target(cr), detail::IMAGE_FORMAT,
+          width, std::ceil(y1 - y0));
+      threads.emplace_back([&, b, y0] {
+        auto const& ctx = cairo_create(surfaces[b]);
+        cairo_translate(ctx, 0, -y0);
+        auto const& pattern = cairo_pattern_create_mesh();
+        for (auto const& k: buckets[b]) {
+          add_patch(pattern, k);
+        }
+        cairo_pattern_set_matrix(pattern, pattern_matrix);
+        cairo_set_source(ctx, pattern);
+        cairo_pattern_destroy(pattern);
+        cairo_paint(ctx);
+        cairo_destroy(ctx);
+      });
+    }
+    for (auto& thread: threads) {
+      thread.join();
+    }
+  }
+  for (auto b = 0; b < n_bands; ++b) {
+    if (auto const& surface = surfaces[b]) {
+      auto const& y0 = b * band_height,
+                & y1 = std::min(height, y0 + band_height);
+      cairo_set_source_surface(cr, surface, 0, y0);
+      cairo_surface_destroy(surface);
+      // Only composite the band (which matters for unbounded operators).
+      cairo_rectangle(cr, 0, y0, width, y1 - y0);
+      cairo_fill(cr);
+    }
+  }
+}
+
 void GraphicsContextRenderer::draw_gouraud_triangles(
   GraphicsContextRenderer& gc,
   py::array_t<double> triangles,
@@ -774,8 +1242,17 @@ void GraphicsContextRenderer::draw_gouraud_triangles(
         triangles, colors)
       .cast<std::string>()};
   }
-  auto const& pattern = cairo_pattern_create_mesh();
-  for (auto i = 0; i < n; ++i) {
+  auto const& extent = [&](int i) {
+    auto y_min = std::numeric_limits<double>::infinity(), y_max = -y_min;
+    for (auto j = 0; j < 3; ++j) {
+      auto x = tri_raw(i, j, 0), y = tri_raw(i, j, 1);
+      cairo_matrix_transform_point(&mtx, &x, &y);
+      y_min = std::min(y_min, y);
+      y_max = std::max(y_max, y);
+    }
+    return std::pair{y_min, y_max};
+  };
+  auto const& add_patch = [&](cairo_pattern_t* pattern, int i) {
     cairo_mesh_pattern_begin_patch(pattern);
     for (auto j = 0; j < 3; ++j) {
       cairo_mesh_pattern_line_to(pattern, tri_raw(i, j, 0), tri_raw(i, j, 1));
@@ -785,12 +1262,10 @@ void GraphicsContextRenderer::draw_gouraud_triangles(
         col_raw(i, j, 2), col_raw(i, j, 3));
     }
     cairo_mesh_pattern_end_patch(pattern);
-  }
-  cairo_matrix_invert(&mtx);
-  cairo_pattern_set_matrix(pattern, &mtx);
-  cairo_set_source(cr_, pattern);
-  cairo_pattern_destroy(pattern);
-  cairo_paint(cr_);
+  };
+  auto inv_mtx = mtx;
+  cairo_matrix_invert(&inv_mtx);
+  paint_mesh(cr_, width_, height_, int(n), &inv_mtx, extent, add_patch);
 }
 
 void GraphicsContextRenderer::draw_image(
@@ -807,32 +1282,36 @@ void GraphicsContextRenderer::draw_image(
       "RGBA array must have shape (m, n, 4), not {.shape}"_format(im)
       .cast<std::string>()};
   }
+  auto const& dither = get_additional_state().dither;
   // Let cairo manage the surface memory; as some backends only write the image
   // at flush time.
   auto const& surface =
     cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
-  auto const& data = cairo_image_surface_get_data(surface);
-  auto const& stride = cairo_image_surface_get_stride(surface);
-  cairo_surface_flush(surface);
-  // The gcr's alpha has already been applied by ImageBase._make_image, we just
-  // need to convert to premultiplied ARGB format.
-  for (auto i = 0; i < height; ++i) {
-    auto ptr = reinterpret_cast<uint32_t*>(data + i * stride);
-    for (auto j = 0; j < width; ++j) {
-      auto r = im_raw(i, j, 0),
-           g = im_raw(i, j, 1),
-           b = im_raw(i, j, 2),
-           a = im_raw(i, j, 3);
-      if (a != 0xff) {
-        auto subtable = &detail::premultiplication_table[a << 8];
-        r = subtable[r];
-        g = subtable[g];
-        b = subtable[b];
+  {
+    [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+    auto const& data = cairo_image_surface_get_data(surface);
+    auto const& stride = cairo_image_surface_get_stride(surface);
+    cairo_surface_flush(surface);
+    // The gcr's alpha has already been applied by ImageBase._make_image, we
+    // just need to convert to premultiplied ARGB format.
+    for (auto i = 0; i < height; ++i) {
+      auto ptr = reinterpret_cast<uint32_t*>(data + i * stride);
+      for (auto j = 0; j < width; ++j) {
+        auto r = im_raw(i, j, 0),
+             g = im_raw(i, j, 1),
+             b = im_raw(i, j, 2),
+             a = im_raw(i, j, 3);
+        if (a != 0xff) {
+          auto subtable = &detail::premultiplication_table[a << 8];
+          r = subtable[r];
+          g = subtable[g];
+          b = subtable[b];
+        }
+        *ptr++ = (a << 24) + (r << 16) + (g << 8) + (b << 0);
       }
-      *ptr++ = (a << 24) + (r << 16) + (g << 8) + (b << 0);
     }
+    cairo_surface_mark_dirty(surface);
   }
-  cairo_surface_mark_dirty(surface);
   if (cairo_surface_get_type(cairo_get_target(cr_)) == CAIRO_SURFACE_TYPE_SVG
       && !rc_param("svg.image_inline").cast<bool>()) {
     if (!path_) {
@@ -864,14 +1343,17 @@ void GraphicsContextRenderer::draw_image(
   }
   auto const& pattern = cairo_pattern_create_for_surface(surface);
   cairo_surface_destroy(surface);
+  // The image spans (width, height) / image_magnification_ in user space.
+  auto const& mag = image_magnification_;
   auto const& mtx =
-    cairo_matrix_t{1, 0, 0, -1, -x, -y + height_};
+    cairo_matrix_t{mag, 0, 0, -mag, -mag * x, mag * (-y + height_)};
   cairo_pattern_set_matrix(pattern, &mtx);
   if (detail::cairo_pattern_set_dither) {
-    detail::cairo_pattern_set_dither(pattern, get_additional_state().dither);
+    detail::cairo_pattern_set_dither(pattern, dither);
   }
   cairo_set_source(cr_, pattern);
   cairo_pattern_destroy(pattern);
+  [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
   cairo_paint(cr_);
 }
 
@@ -887,110 +1369,247 @@ void GraphicsContextRenderer::draw_path(
   [[maybe_unused]] auto const& ac = _additional_context();
   auto path_loaded = false;
   auto mtx = matrix_from_transform(transform, height_);
+  auto simplify_threshold = 0.;
+  // Cleaned paths are new objects every time, so don't bother caching them.
+  auto cache_path = true;
   auto const& load_path = [&] {
     if (!path_loaded) {
-      load_path_exact(cr_, path, &mtx);
+      if (simplify_threshold) {
+        auto const& vertices =
+          path.attr("vertices").cast<py::array_t<double>>();
+        load_path_exact(
+          cr_, vertices, 0, vertices.shape(0), &mtx, simplify_threshold);
+      } else if (cache_path) {
+        load_path_cached(cr_, path, &mtx);
+      } else {
+        load_path_exact(cr_, path, &mtx);
+      }
       path_loaded = true;
     }
   };
-  auto const& hatch_path =
-    py::cast(this).attr("get_hatch_path")().cast<std::optional<py::object>>();
+  auto const& hatch_pattern = get_hatch_pattern();
   auto const& simplify =
-    path.attr("should_simplify").cast<bool>() && !fc && !hatch_path;
+    path.attr("should_simplify").cast<bool>() && !fc && !hatch_pattern;
   auto const& sketch = get_additional_state().sketch;
-  if (simplify || sketch) {
-    // TODO: cairo internally uses vertex reduction and Douglas-Peucker, but it
-    // is unclear whether it also applies to vector output?  See mplcairo#37.
+  auto const& chunksize = rc_param("agg.path.chunksize").cast<int>();
+  // Python-side data is all retrieved by now (or by load_path_exact, which
+  // acquires the GIL as needed), so release the GIL while cairo rasterizes.
+  auto const& fill_preserve_nogil = [&] {
+    [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+    cairo_fill_preserve(cr_);
+  };
+  auto const& stroke_nogil = [&] {
+    [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+    cairo_stroke(cr_);
+  };
+  // Fast path for filled axis-aligned rectangles without edges (bars,
+  // spans...; Matplotlib sets the linewidth to zero for invisible edges) on
+  // raster surfaces: fill them with cairo_rectangle (snapped between pixels,
+  // as load_path_exact does for zero linewidths, so that cairo's box
+  // compositor fills whole pixel spans), and skip the stroke altogether.
+  if (fc && !hatch_pattern && !sketch && !has_vector_surface(cr_)
+      && cairo_get_line_width(cr_) == 0) {
+    if (auto const& rect = rectangle_extents(path, &mtx)) {
+      auto const& [x, y, w, h] = *rect;
+      // Clamped as in load_path_exact.
+      auto const& min = double(-(1 << 22)), max = double(1 << 22);
+      auto x0 = std::clamp(x, min, max), y0 = std::clamp(y, min, max),
+           x1 = std::clamp(x + w, min, max), y1 = std::clamp(y + h, min, max);
+      if (get_additional_state().snap) {
+        x0 = std::round(x0);
+        y0 = std::round(y0);
+        x1 = std::round(x1);
+        y1 = std::round(y1);
+      }
+      auto const& [r, g, b, a] = to_rgba(*fc, get_additional_state().alpha);
+      cairo_save(cr_);
+      restore_init_matrix(cr_);
+      cairo_new_path(cr_);
+      cairo_rectangle(cr_, x0, y0, x1 - x0, y1 - y0);
+      cairo_set_source_rgba(cr_, r, g, b, a);
+      {
+        [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+        cairo_fill(cr_);
+      }
+      cairo_restore(cr_);
+      return;
+    }
+  }
+  if (simplify && !sketch && path.attr("codes").is_none()) {
+    // Codeless paths (the common case of long lines) are simplified natively,
+    // in screen space, while loading them.
+    simplify_threshold = rc_param("path.simplify_threshold").cast<double>();
+  } else if (simplify || sketch) {
     path = path.attr("cleaned")(
       "transform"_a=transform, "simplify"_a=simplify, "curves"_a=true,
       "sketch"_a=sketch);
     mtx = cairo_matrix_t{1, 0, 0, -1, 0, height_};
+    cache_path = false;
   }
   if (fc) {
     load_path();
     cairo_save(cr_);
     auto const& [r, g, b, a] = to_rgba(*fc, get_additional_state().alpha);
     cairo_set_source_rgba(cr_, r, g, b, a);
-    cairo_fill_preserve(cr_);
+    fill_preserve_nogil();
     cairo_restore(cr_);
   }
-  if (hatch_path) {
+  if (hatch_pattern) {
     cairo_save(cr_);
-    auto const& dpi = int(dpi_);  // Truncating is good enough.
-    auto const& hatch_surface =
-      cairo_surface_create_similar(
-        cairo_get_target(cr_), CAIRO_CONTENT_COLOR_ALPHA, dpi, dpi);
-    auto const& hatch_cr = cairo_create(hatch_surface);
-    cairo_surface_destroy(hatch_surface);
-    auto hatch_gcr = GraphicsContextRenderer{
-      hatch_cr, double(dpi), double(dpi), double(dpi)};
-    hatch_gcr.get_additional_state().snap = false;
-    hatch_gcr.set_linewidth(get_additional_state().get_hatch_linewidth());
-    auto const& mtx =
-      cairo_matrix_t{double(dpi), 0, 0, -double(dpi), 0, double(dpi)};
-    auto const& hatch_color = get_additional_state().get_hatch_color();
-    fill_and_stroke_exact(
-      hatch_cr, *hatch_path, &mtx, hatch_color, hatch_color);
-    auto const& hatch_pattern =
-      cairo_pattern_create_for_surface(hatch_surface);
-    cairo_pattern_set_extend(hatch_pattern, CAIRO_EXTEND_REPEAT);
     cairo_set_source(cr_, hatch_pattern);
-    cairo_pattern_destroy(hatch_pattern);
     load_path();
-    cairo_fill_preserve(cr_);
+    fill_preserve_nogil();
     cairo_restore(cr_);
   }
-  auto const& chunksize = rc_param("agg.path.chunksize").cast<int>();
   if (path_loaded || !chunksize || !path.attr("codes").is_none()) {
     load_path();
-    cairo_stroke(cr_);
+    stroke_nogil();
   } else {
     auto const& vertices = path.attr("vertices").cast<py::array_t<double>>();
     auto const& n = vertices.shape(0);
-    for (auto i = decltype(n)(0); i < n; i += chunksize) {
-      load_path_exact(cr_, vertices, i, std::min(i + chunksize + 1, n), &mtx);
-      cairo_stroke(cr_);
+    auto const& n_chunks = int((n + chunksize - 1) / chunksize);
+    if (detail::COLLECTION_THREADS && n_chunks > 1
+        && !has_vector_surface(cr_)
+        && cairo_pattern_get_type(cairo_get_source(cr_))
+           == CAIRO_PATTERN_TYPE_SOLID) {
+      // Chunks are independent strokes: load them upfront (which requires
+      // the GIL), then stroke them in parallel and composite the results.
+      // As in draw_path_collection, threads do not share cr_'s source
+      // (pattern refcounting is not thread-safe) but set their own, and the
+      // line style is read once, before they start.
+      using path_ptr =
+        std::unique_ptr<cairo_path_t, decltype(&cairo_path_destroy)>;
+      auto chunks = std::vector<path_ptr>{};
+      for (auto i = decltype(n)(0); i < n; i += chunksize) {
+        load_path_exact(
+          cr_, vertices, i, std::min(i + chunksize + 1, n), &mtx,
+          simplify_threshold);
+        chunks.emplace_back(cairo_copy_path(cr_), cairo_path_destroy);
+        CAIRO_CHECK(cairo_status, cr_);
+      }
+      cairo_new_path(cr_);
+      auto const& dash_count = cairo_get_dash_count(cr_);
+      auto const& dashes = std::unique_ptr<double[]>{new double[dash_count]};
+      double dash_offset;
+      cairo_get_dash(cr_, dashes.get(), &dash_offset);
+      double r, g, b, a;
+      CAIRO_CHECK(
+        cairo_pattern_get_rgba, cairo_get_source(cr_), &r, &g, &b, &a);
+      auto const& antialias = cairo_get_antialias(cr_);
+      auto const& line_cap = cairo_get_line_cap(cr_);
+      auto const& line_join = cairo_get_line_join(cr_);
+      auto const& line_width = cairo_get_line_width(cr_);
+      auto const& miter_limit = cairo_get_miter_limit(cr_);
+      maybe_multithread(
+        cr_, width_, height_, n_chunks, [&](cairo_t* ctx, int start, int stop) {
+          if (ctx != cr_) {
+            cairo_set_source_rgba(ctx, r, g, b, a);
+            cairo_set_antialias(ctx, antialias);
+            cairo_set_line_cap(ctx, line_cap);
+            cairo_set_line_join(ctx, line_join);
+            cairo_set_line_width(ctx, line_width);
+            cairo_set_miter_limit(ctx, miter_limit);
+            cairo_set_dash(ctx, dashes.get(), dash_count, dash_offset);
+          }
+          for (auto i = start; i < stop; ++i) {
+            cairo_append_path(ctx, chunks[i].get());
+            cairo_stroke(ctx);
+          }
+        });
+    } else {
+      for (auto i = decltype(n)(0); i < n; i += chunksize) {
+        load_path_exact(
+          cr_, vertices, i, std::min(i + chunksize + 1, n), &mtx,
+          simplify_threshold);
+        stroke_nogil();
+      }
     }
   }
 }
 
-template<typename T>
-void maybe_multithread(
-  cairo_t* cr, double width, double height, int n, T /* lambda */ worker)
+// Draw many paths sharing the same GraphicsContext and transform, avoiding the
+// per-call overhead of draw_path (e.g. for plots with thousands of individual
+// lines).  Filled paths are filled and stroked one at a time, exactly as
+// draw_path would; unfilled paths are loaded together and stroked at once (so,
+// unlike separate draw_path calls, overlapping translucent strokes are
+// composited only once).
+void GraphicsContextRenderer::draw_paths_batched(
+  GraphicsContextRenderer& gc,
+  std::vector<py::object> paths,
+  py::object transform,
+  std::optional<py::object> fc)
 {
-  if (detail::COLLECTION_THREADS) {
-    auto const& chunk_size =
-      int(std::ceil(double(n) / detail::COLLECTION_THREADS));
-    auto ctxs = std::vector<cairo_t*>{};
-    auto threads = std::vector<std::thread>{};
-    for (auto i = 0; i < detail::COLLECTION_THREADS; ++i) {
-      auto const& surface =
-        cairo_surface_create_similar_image(
-          cairo_get_target(cr), detail::IMAGE_FORMAT, width, height);
-      auto const& ctx = cairo_create(surface);
-      cairo_surface_destroy(surface);
-      ctxs.push_back(ctx);
-      threads.emplace_back(
-        worker, ctx, chunk_size * i, std::min<int>(chunk_size * (i + 1), n));
+  if (&gc != this) {
+    throw std::invalid_argument{"non-matching GraphicsContext"};
+  }
+  if (get_hatch_pattern() || get_additional_state().sketch) {
+    for (auto const& path: paths) {
+      draw_path(gc, path, transform, fc);
     }
-    {
+    return;
+  }
+  auto const& mtx = matrix_from_transform(transform, height_);
+  if (fc) {
+    [[maybe_unused]] auto const& ac = _additional_context();
+    auto const& [r, g, b, a] = to_rgba(*fc, get_additional_state().alpha);
+    for (auto const& path: paths) {
+      load_path_cached(cr_, path, &mtx);
       [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
-      for (auto& thread: threads) {
-        thread.join();
+      cairo_save(cr_);
+      cairo_set_source_rgba(cr_, r, g, b, a);
+      cairo_fill_preserve(cr_);
+      cairo_restore(cr_);
+      cairo_stroke(cr_);
+    }
+    return;
+  }
+  // Same simplification logic as draw_path; paths that draw_path would split
+  // into chunks are left to it, after stroking the paths batched before them
+  // (so that the drawing order is preserved).
+  auto const& cleaned_mtx = cairo_matrix_t{1, 0, 0, -1, 0, height_};
+  auto const& simplify_threshold =
+    rc_param("path.simplify_threshold").cast<double>();
+  auto const& chunksize = rc_param("agg.path.chunksize").cast<int>();
+  auto const& stroke_batch = [&](auto begin, auto end) {
+    if (begin == end) {
+      return;
+    }
+    [[maybe_unused]] auto const& ac = _additional_context();
+    cairo_new_path(cr_);
+    for (auto it = begin; it != end; ++it) {
+      auto const& path = *it;
+      if (!path.attr("should_simplify").cast<bool>()) {
+        load_path_exact(cr_, path, &mtx, true);
+      } else if (path.attr("codes").is_none()) {
+        auto const& vertices =
+          path.attr("vertices").cast<py::array_t<double>>();
+        load_path_exact(
+          cr_, vertices, 0, vertices.shape(0), &mtx, simplify_threshold,
+          true);
+      } else {
+        load_path_exact(
+          cr_,
+          path.attr("cleaned")(
+            "transform"_a=transform, "simplify"_a=true, "curves"_a=true),
+          &cleaned_mtx, true);
       }
     }
-    for (auto const& ctx: ctxs) {
-      auto const& pattern =
-        cairo_pattern_create_for_surface(cairo_get_target(ctx));
-      cairo_destroy(ctx);
-      cairo_set_source(cr, pattern);
-      cairo_pattern_destroy(pattern);
-      cairo_paint(cr);
+    CAIRO_CHECK(cairo_status, cr_);
+    [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+    cairo_stroke(cr_);
+  };
+  auto batch_begin = paths.begin();
+  for (auto it = paths.begin(); it != paths.end(); ++it) {
+    auto const& path = *it;
+    if (chunksize && path.attr("codes").is_none()
+        && path.attr("vertices").cast<py::array_t<double>>().shape(0)
+           > chunksize) {
+      stroke_batch(batch_begin, it);
+      draw_path(gc, path, transform, {});
+      batch_begin = it + 1;
     }
   }
-  else {
-    worker(cr, 0, n);
-  }
+  stroke_batch(batch_begin, paths.end());
 }
 
 void GraphicsContextRenderer::draw_markers(
@@ -1036,6 +1655,39 @@ void GraphicsContextRenderer::draw_markers(
     fill_and_stroke_exact(cr, marker_path, &m, fc_raw_opt, ec_raw);
   };
 
+  // Load the marker path (at the origin) and return its extents.
+  auto const& marker_extents = [&] {
+    load_path_exact(cr_, marker_path, &marker_matrix);
+    // Importantly, cairo_*_extents() ignores surface dimensions and clipping.
+    // Matplotlib chooses *not* to call draw_markers() if the marker is bigger
+    // than the canvas (which may make sense if the marker is indeed huge...).
+    double x0, y0, x1, y1;
+    cairo_stroke_extents(cr_, &x0, &y0, &x1, &y1);
+    if (fc) {
+      double x0f, y0f, x1f, y1f;
+      cairo_fill_extents(cr_, &x0f, &y0f, &x1f, &y1f);
+      x0 = std::min(x0, x0f);
+      y0 = std::min(y0, y0f);
+      x1 = std::max(x1, x1f);
+      y1 = std::max(y1, y1f);
+    }
+    cairo_new_path(cr_);
+    return std::tuple{x0, y0, x1, y1};
+  };
+
+  auto const& copy_line_style = [&](cairo_t* cr) -> void {
+    cairo_set_antialias(cr, cairo_get_antialias(cr_));
+    cairo_set_line_cap(cr, cairo_get_line_cap(cr_));
+    cairo_set_line_join(cr, cairo_get_line_join(cr_));
+    cairo_set_line_width(cr, cairo_get_line_width(cr_));
+    cairo_set_miter_limit(cr, cairo_get_miter_limit(cr_));
+    auto const& dash_count = cairo_get_dash_count(cr_);
+    auto const& dashes = std::unique_ptr<double[]>{new double[dash_count]};
+    double offset;
+    cairo_get_dash(cr_, dashes.get(), &offset);
+    cairo_set_dash(cr, dashes.get(), dash_count, offset);
+  };
+
   // Pixel markers *must* be drawn snapped.
   auto const& is_pixel_marker =
     py_eq(marker_path, detail::PIXEL_MARKER.attr("get_path")())
@@ -1058,22 +1710,9 @@ void GraphicsContextRenderer::draw_markers(
     // this branch.
     auto const& old_snap = get_additional_state().snap;
     get_additional_state().snap = false;
-    load_path_exact(cr_, marker_path, &marker_matrix);
+    double x0, y0, x1, y1;  // Not a structured binding, to allow capture.
+    std::tie(x0, y0, x1, y1) = marker_extents();
     get_additional_state().snap = old_snap;
-    // Get the extent of the marker.  Importantly, cairo_*_extents() ignores
-    // surface dimensions and clipping.
-    // Matplotlib chooses *not* to call draw_markers() if the marker is bigger
-    // than the canvas (which may make sense if the marker is indeed huge...).
-    double x0, y0, x1, y1;
-    cairo_stroke_extents(cr_, &x0, &y0, &x1, &y1);
-    if (fc) {
-      double x0f, y0f, x1f, y1f;
-      cairo_fill_extents(cr_, &x0f, &y0f, &x1f, &y1f);
-      x0 = std::min(x0, x0f);
-      y0 = std::min(y0, y0f);
-      x1 = std::max(x1, x1f);
-      y1 = std::max(y1, y1f);
-    }
     x0 = std::floor(x0 / n_subpix) * n_subpix;
     y0 = std::floor(y0 / n_subpix) * n_subpix;
 
@@ -1084,15 +1723,7 @@ void GraphicsContextRenderer::draw_markers(
           cairo_get_target(cr_), detail::IMAGE_FORMAT,
           std::ceil(x1 - x0 + 1), std::ceil(y1 - y0 + 1)));
     auto const& raster_cr = raster_gcr.cr_;
-    cairo_set_antialias(raster_cr, cairo_get_antialias(cr_));
-    cairo_set_line_cap(raster_cr, cairo_get_line_cap(cr_));
-    cairo_set_line_join(raster_cr, cairo_get_line_join(cr_));
-    cairo_set_line_width(raster_cr, cairo_get_line_width(cr_));
-    auto const& dash_count = cairo_get_dash_count(cr_);
-    auto const& dashes = std::unique_ptr<double[]>{new double[dash_count]};
-    double offset;
-    cairo_get_dash(cr_, dashes.get(), &offset);
-    cairo_set_dash(raster_cr, dashes.get(), dash_count, offset);
+    copy_line_style(raster_cr);
     double r, g, b, a;
     CAIRO_CHECK(cairo_pattern_get_rgba, cairo_get_source(cr_), &r, &g, &b, &a);
     cairo_set_source_rgba(raster_cr, r, g, b, a);
@@ -1161,6 +1792,41 @@ void GraphicsContextRenderer::draw_markers(
     }
     cairo_surface_mark_dirty(surface);
 
+  } else if (has_vector_surface(cr_) && n_vertices > 1) {
+    // Record the marker once, then paint the recording at each vertex: the
+    // PDF and SVG backends emit the recording only once (as a Form XObject,
+    // or as a definition referenced by <use> elements) and merely reference
+    // it afterwards.
+    auto const& [x0, y0, x1, y1] = marker_extents();
+    auto const& extents = cairo_rectangle_t{
+      std::floor(x0) - 1, std::floor(y0) - 1,
+      std::ceil(x1) - std::floor(x0) + 2, std::ceil(y1) - std::floor(y0) + 2};
+    auto const& marker =
+      cairo_recording_surface_create(CAIRO_CONTENT_COLOR_ALPHA, &extents);
+    {
+      auto marker_gcr =
+        GraphicsContextRenderer{
+          cairo_create(marker), extents.width, extents.height, 72};
+      // Snapping at the origin would be meaningless after translation.
+      marker_gcr.get_additional_state().snap = false;
+      copy_line_style(marker_gcr.cr_);
+      draw_one_marker(marker_gcr.cr_, 0, 0);
+    }
+    auto const& pattern = cairo_pattern_create_for_surface(marker);
+    cairo_surface_destroy(marker);
+    for (auto i = 0; i < n_vertices; ++i) {
+      auto x = vertices(i, 0), y = vertices(i, 1);
+      cairo_matrix_transform_point(&mtx, &x, &y);
+      if (!(std::isfinite(x) && std::isfinite(y))) {
+        continue;
+      }
+      auto const& pattern_matrix = cairo_matrix_t{1, 0, 0, 1, -x, -y};
+      cairo_pattern_set_matrix(pattern, &pattern_matrix);
+      cairo_set_source(cr_, pattern);
+      cairo_paint(cr_);
+    }
+    cairo_pattern_destroy(pattern);
+
   } else {
     for (auto i = 0; i < n_vertices; ++i) {
       cairo_save(cr_);
@@ -1196,15 +1862,10 @@ void GraphicsContextRenderer::draw_path_collection(
   // PatternCache currently uses handles rather than object for multithreading
   // support, which means that key lifetimes are tied to the *paths* argument.
 
-  // Fall back onto the slow implementation in the following, non-supported
-  // cases:
-  // - Hatching is used: the stamp cache cannot be used anymore, as the hatch
-  //   positions would be different on every stamp.  (NOTE: Actually it may be
-  //   possible to use the hatch as the source and mask it with the pattern.)
-  // - offset_position is set to "data".  This feature was only used by
-  //   hexbin() and only in mpl<3.3 (#13696).
-  if (py::bool_(py::cast(this).attr("get_hatch")())
-      || offset_position == "data") {
+  // Fall back onto the slow implementation if offset_position is set to
+  // "data".  This feature was only used by hexbin() and only in mpl<3.3
+  // (#13696).
+  if (offset_position == "data") {
     renderer_base("draw_path_collection")(
       this, gc, master_transform, paths, transforms, offsets, offset_transform,
       fcs, ecs, lws, dashes, aas, urls, offset_position);
@@ -1272,6 +1933,27 @@ void GraphicsContextRenderer::draw_path_collection(
   auto const& simplify_threshold =
     has_vector_surface(cr_)
     ? 0 : rc_param("path.simplify_threshold").cast<double>();
+  // Hatches are drawn by masking the (repeating) hatch source with the fill
+  // stamps; as the hatch is anchored to the canvas, the stamps stay valid.
+  // Threads cannot share the hatch pattern (pattern and pixman image
+  // refcounting is not thread-safe), so give them a raster copy of the tile
+  // instead, which each of them wraps in its own pattern.
+  auto const& hatch_pattern = get_hatch_pattern();
+  auto const& hatch_tile =
+    std::unique_ptr<cairo_surface_t, decltype(&cairo_surface_destroy)>{
+      hatch_pattern && detail::COLLECTION_THREADS
+      ? cairo_image_surface_create(
+        CAIRO_FORMAT_ARGB32, int(dpi_), int(dpi_))
+      : nullptr,
+      cairo_surface_destroy};
+  if (hatch_tile) {
+    auto const& tile_cr = cairo_create(hatch_tile.get());
+    cairo_set_source(tile_cr, hatch_pattern);
+    cairo_paint(tile_cr);
+    cairo_destroy(tile_cr);
+    cairo_surface_flush(hatch_tile.get());
+    CAIRO_CHECK(cairo_surface_status, hatch_tile.get());
+  }
 
   maybe_multithread(
     cr_, width_, height_, n, [&](cairo_t* ctx, int start, int stop) {
@@ -1280,6 +1962,24 @@ void GraphicsContextRenderer::draw_path_collection(
           cairo_set_user_data, ctx, &detail::STATE_KEY,
           std::stack<AdditionalState>{{get_additional_state()}});
       }
+      auto thread_hatch_pattern =
+        std::unique_ptr<cairo_pattern_t, decltype(&cairo_pattern_destroy)>{
+          nullptr, cairo_pattern_destroy};
+      if (hatch_tile) {
+        auto const& surface =
+          cairo_image_surface_create_for_data(
+            cairo_image_surface_get_data(hatch_tile.get()),
+            CAIRO_FORMAT_ARGB32,
+            cairo_image_surface_get_width(hatch_tile.get()),
+            cairo_image_surface_get_height(hatch_tile.get()),
+            cairo_image_surface_get_stride(hatch_tile.get()));
+        thread_hatch_pattern.reset(cairo_pattern_create_for_surface(surface));
+        cairo_surface_destroy(surface);
+        cairo_pattern_set_extend(
+          thread_hatch_pattern.get(), CAIRO_EXTEND_REPEAT);
+      }
+      auto const& hatch =
+        hatch_tile ? thread_hatch_pattern.get() : hatch_pattern;
       auto cache = PatternCache{simplify_threshold};
       for (auto i = start; i < stop; ++i) {
         auto const& path = paths[i % n_paths];
@@ -1298,6 +1998,11 @@ void GraphicsContextRenderer::draw_path_collection(
           cache.mask(
             ctx, width_, height_, path, mtx, draw_func_t::Fill, 0, {}, x, y);
         }
+        if (hatch) {
+          cairo_set_source(ctx, hatch);
+          cache.mask(
+            ctx, width_, height_, path, mtx, draw_func_t::Fill, 0, {}, x, y);
+        }
         if (ecs_raw.shape(0)) {
           auto const& i_mod = i % ecs_raw.shape(0);
           cairo_set_source_rgba(
@@ -1368,91 +2073,218 @@ void GraphicsContextRenderer::draw_quad_mesh(
     offset_transform.attr("transform")(offsets).cast<py::array_t<double>>();
   mtx.x0 += tr_offset.at(0, 0),
   mtx.y0 -= tr_offset.at(0, 1);
-  auto coords_raw_keepref =  // Let numpy manage the buffer.
-    coordinates.attr("copy")().cast<py::array_t<double>>();
-  auto coords_raw = coords_raw_keepref.mutable_unchecked<3>();
-  for (auto i = 0; i < mesh_height + 1; ++i) {
-    for (auto j = 0; j < mesh_width + 1; ++j) {
-      cairo_matrix_transform_point(
-        &mtx,
-        coords_raw.mutable_data(i, j, 0), coords_raw.mutable_data(i, j, 1));
+  // Transform the vertices, row by row (to support any strides), into
+  // scratch buffers, and precompute their finiteness, so that the validity of
+  // a quad is just a check of its four corners' flags.
+  auto const& n_vertices = (mesh_height + 1) * (mesh_width + 1);
+  auto const& xs = std::unique_ptr<double[]>{new double[n_vertices]},
+            & ys = std::unique_ptr<double[]>{new double[n_vertices]};
+  auto const& finite = std::unique_ptr<uint8_t[]>{new uint8_t[n_vertices]};
+  {
+    [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+    auto const& data = static_cast<char const*>(coordinates.data());
+    for (auto i = 0; i < mesh_height + 1; ++i) {
+      transform_points(
+        &mtx, data + i * coordinates.strides(0), mesh_width + 1,
+        coordinates.strides(1), coordinates.strides(2),
+        xs.get() + i * (mesh_width + 1), ys.get() + i * (mesh_width + 1));
+    }
+    for (auto k = ssize_t{}; k < n_vertices; ++k) {
+      // Branchless std::isfinite(x) && std::isfinite(y).
+      finite[k] = (xs[k] - xs[k] == 0) & (ys[k] - ys[k] == 0);
     }
   }
-  // If edge colors are set, we need to draw the quads one at a time in
-  // order to be able to draw the edges as well.  If they are not set, using
-  // cairo's mesh pattern support instead avoids conflation artefacts.
+  auto const& vx = [&](ssize_t i, ssize_t j) {
+    return xs[i * (mesh_width + 1) + j];
+  };
+  auto const& vy = [&](ssize_t i, ssize_t j) {
+    return ys[i * (mesh_width + 1) + j];
+  };
+  // Fast path for rectilinear meshes (e.g. pcolormesh on regular grids,
+  // possibly with nonuniform spacing) on raster surfaces: render them as an
+  // image, with each pixel taking the color of the cell containing its center
+  // (in device space, hence the restriction to integer translations).
+  auto const& draw_rectilinear = [&]() -> bool {
+    cairo_matrix_t ctm;
+    cairo_get_matrix(cr_, &ctm);
+    if (has_vector_surface(cr_)
+        || !mesh_width || !mesh_height
+        || ctm.xx != 1 || ctm.yx != 0 || ctm.xy != 0 || ctm.yy != 1
+        || ctm.x0 != std::round(ctm.x0) || ctm.y0 != std::round(ctm.y0)) {
+      return false;
+    }
+    [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+    auto const& x_edges =
+      std::unique_ptr<double[]>{new double[mesh_width + 1]};
+    auto const& y_edges =
+      std::unique_ptr<double[]>{new double[mesh_height + 1]};
+    for (auto j = 0; j < mesh_width + 1; ++j) {
+      x_edges[j] = vx(0, j) + ctm.x0;
+    }
+    for (auto i = 0; i < mesh_height + 1; ++i) {
+      y_edges[i] = vy(i, 0) + ctm.y0;
+    }
+    for (auto i = 0; i < mesh_height + 1; ++i) {
+      for (auto j = 0; j < mesh_width + 1; ++j) {
+        // Also rejects nans.
+        if (!(vx(i, j) + ctm.x0 == x_edges[j]
+              && vy(i, j) + ctm.y0 == y_edges[i])) {
+          return false;
+        }
+      }
+    }
+    // Map pixel centers to cell indices (-1 if not monotonic or not finite).
+    auto const& index_map = [](double const* edges, ssize_t n, int size)
+      -> std::tuple<int, std::vector<int>>
+    {
+      auto const& increasing = edges[0] <= edges[n];
+      for (auto k = 0; k < n + 1; ++k) {
+        if (!std::isfinite(edges[k])
+            || (k && (increasing ? edges[k] < edges[k - 1]
+                                 : edges[k] > edges[k - 1]))) {
+          return {-1, {}};
+        }
+      }
+      auto const& lo = std::min(edges[0], edges[n]),
+                & hi = std::max(edges[0], edges[n]);
+      // Pixels whose centers are in [lo, hi).
+      auto const& start = int(std::clamp(std::ceil(lo - .5), 0., double(size))),
+                & stop = int(std::clamp(std::ceil(hi - .5), 0., double(size)));
+      auto map = std::vector<int>(std::max(stop - start, 0));
+      for (auto p = start; p < stop; ++p) {
+        auto const& c = p + .5;
+        auto const& k =
+          increasing
+          ? std::upper_bound(edges, edges + n + 1, c) - edges
+          : std::upper_bound(edges, edges + n + 1, c, std::greater<>{})
+            - edges;
+        map[p - start] = int(std::clamp<ssize_t>(k - 1, 0, n - 1));
+      }
+      return {start, map};
+    };
+    auto const& [x_start, col_map] =
+      index_map(x_edges.get(), mesh_width, int(width_));
+    auto const& [y_start, row_map] =
+      index_map(y_edges.get(), mesh_height, int(height_));
+    if (x_start < 0 || y_start < 0) {
+      return false;
+    }
+    auto const& w = int(col_map.size()), h = int(row_map.size());
+    if (!w || !h) {
+      return true;  // Entirely out of the canvas.
+    }
+    auto const& surface =
+      std::unique_ptr<cairo_surface_t, decltype(&cairo_surface_destroy)>{
+        cairo_image_surface_create(CAIRO_FORMAT_ARGB32, w, h),
+        cairo_surface_destroy};
+    CAIRO_CHECK(cairo_surface_status, surface.get());
+    auto const& data = cairo_image_surface_get_data(surface.get());
+    auto const& stride = cairo_image_surface_get_stride(surface.get());
+    auto const& row_colors =
+      std::unique_ptr<uint32_t[]>{new uint32_t[mesh_width]};
+    auto last_i = -1;
+    for (auto y = 0; y < h; ++y) {
+      if (auto const& i = row_map[y]; i != last_i) {
+        for (auto j = 0; j < mesh_width; ++j) {
+          auto const& n = i * mesh_width + j;
+          auto const& a = std::clamp(fcs_raw(n, 3), 0., 1.);
+          auto const& to_u8 = [&](double c) {
+            return uint32_t(std::lround(255 * std::clamp(c, 0., 1.) * a));
+          };
+          row_colors[j] =
+            uint32_t(std::lround(255 * a)) << 24 | to_u8(fcs_raw(n, 0)) << 16
+            | to_u8(fcs_raw(n, 1)) << 8 | to_u8(fcs_raw(n, 2));
+        }
+        last_i = i;
+      }
+      auto const& row = reinterpret_cast<uint32_t*>(data + y * stride);
+      for (auto x = 0; x < w; ++x) {
+        row[x] = row_colors[col_map[x]];
+      }
+    }
+    cairo_surface_mark_dirty(surface.get());
+    cairo_set_source_surface(
+      cr_, surface.get(), x_start - ctm.x0, y_start - ctm.y0);
+    cairo_paint(cr_);
+    return true;
+  };
+  auto const& is_finite = [&](ssize_t i, ssize_t j) {
+    auto const& k = i * (mesh_width + 1) + j;
+    return
+      finite[k] & finite[k + 1]
+      & finite[k + mesh_width + 1] & finite[k + mesh_width + 2];
+  };
+  // Fill the quads using cairo's mesh pattern support, which avoids the
+  // conflation artefacts of filling them one at a time, unless the rectilinear
+  // fast path applies.
   // (FIXME[matplotlib]: In fact, it may make sense to rewrite hexbin in terms
   // of quadmeshes in order to fix their long-standing issues with such
   // artefacts.)
+  if (!draw_rectilinear()) {
+    auto const& extent = [&](int n) {
+      auto const& i = n / mesh_width, j = n % mesh_width;
+      if (!is_finite(i, j)) {  // Never intersects any band.
+        return std::pair{std::numeric_limits<double>::infinity(),
+                         -std::numeric_limits<double>::infinity()};
+      }
+      auto const& [y_min, y_max] =
+        std::minmax({vy(i, j), vy(i, j + 1), vy(i + 1, j), vy(i + 1, j + 1)});
+      return std::pair{y_min, y_max};
+    };
+    auto const& add_patch = [&](cairo_pattern_t* pattern, int n) {
+      auto const& i = n / mesh_width, j = n % mesh_width;
+      if (!is_finite(i, j)) {
+        return;
+      }
+      cairo_mesh_pattern_begin_patch(pattern);
+      cairo_mesh_pattern_move_to(pattern, vx(i, j), vy(i, j));
+      cairo_mesh_pattern_line_to(pattern, vx(i, j + 1), vy(i, j + 1));
+      cairo_mesh_pattern_line_to(pattern, vx(i + 1, j + 1), vy(i + 1, j + 1));
+      cairo_mesh_pattern_line_to(pattern, vx(i + 1, j), vy(i + 1, j));
+      auto const& r = fcs_raw(n, 0),
+                & g = fcs_raw(n, 1),
+                & b = fcs_raw(n, 2),
+                & a = fcs_raw(n, 3);
+      for (auto k = 0; k < 4; ++k) {
+        cairo_mesh_pattern_set_corner_color_rgba(pattern, k, r, g, b, a);
+      }
+      cairo_mesh_pattern_end_patch(pattern);
+    };
+    auto const& id = cairo_matrix_t{1, 0, 0, 1, 0, 0};
+    paint_mesh(
+      cr_, width_, height_, int(mesh_height * mesh_width), &id,
+      extent, add_patch);
+  }
+  // Then stroke the edges, accumulating all the quads sharing an edge color
+  // into a single path.  Unlike stroking each quad separately, edges shared by
+  // adjacent quads are thus drawn only once (if they have the same color).
   if (ecs_raw.shape(0)) {
+    [[maybe_unused]] auto const& nogil = py::gil_scoped_release{};
+    auto quads = std::map<rgba_t, std::vector<ssize_t>>{};
     for (auto i = 0; i < mesh_height; ++i) {
       for (auto j = 0; j < mesh_width; ++j) {
-        if (!(std::isfinite(coords_raw(i, j, 0))
-              && std::isfinite(coords_raw(i, j, 1))
-              && std::isfinite(coords_raw(i, j + 1, 0))
-              && std::isfinite(coords_raw(i, j + 1, 1))
-              && std::isfinite(coords_raw(i + 1, j, 0))
-              && std::isfinite(coords_raw(i + 1, j, 1))
-              && std::isfinite(coords_raw(i + 1, j + 1, 0))
-              && std::isfinite(coords_raw(i + 1, j + 1, 1)))) {
+        if (!is_finite(i, j)) {
           continue;
         }
-        cairo_move_to(
-          cr_, coords_raw(i, j, 0), coords_raw(i, j, 1));
-        cairo_line_to(
-          cr_, coords_raw(i, j + 1, 0), coords_raw(i, j + 1, 1));
-        cairo_line_to(
-          cr_, coords_raw(i + 1, j + 1, 0), coords_raw(i + 1, j + 1, 1));
-        cairo_line_to(
-          cr_, coords_raw(i + 1, j, 0), coords_raw(i + 1, j, 1));
-        cairo_close_path(cr_);
-        auto n = i * mesh_width + j;
-        cairo_set_source_rgba(
-          cr_, fcs_raw(n, 0), fcs_raw(n, 1), fcs_raw(n, 2), fcs_raw(n, 3));
-        cairo_fill_preserve(cr_);
-        n %= ecs_raw.shape(0);
-        cairo_set_source_rgba(
-          cr_, ecs_raw(n, 0), ecs_raw(n, 1), ecs_raw(n, 2), ecs_raw(n, 3));
-        cairo_stroke(cr_);
+        auto const& n = (i * mesh_width + j) % ecs_raw.shape(0);
+        quads[{ecs_raw(n, 0), ecs_raw(n, 1), ecs_raw(n, 2), ecs_raw(n, 3)}]
+          .push_back(i * mesh_width + j);
       }
     }
-  } else {
-    auto const& pattern = cairo_pattern_create_mesh();
-    for (auto i = 0; i < mesh_height; ++i) {
-      for (auto j = 0; j < mesh_width; ++j) {
-        if (!(std::isfinite(coords_raw(i, j, 0))
-              && std::isfinite(coords_raw(i, j, 1))
-              && std::isfinite(coords_raw(i, j + 1, 0))
-              && std::isfinite(coords_raw(i, j + 1, 1))
-              && std::isfinite(coords_raw(i + 1, j, 0))
-              && std::isfinite(coords_raw(i + 1, j, 1))
-              && std::isfinite(coords_raw(i + 1, j + 1, 0))
-              && std::isfinite(coords_raw(i + 1, j + 1, 1)))) {
-          continue;
-        }
-        cairo_mesh_pattern_begin_patch(pattern);
-        cairo_mesh_pattern_move_to(
-          pattern, coords_raw(i, j, 0), coords_raw(i, j, 1));
-        cairo_mesh_pattern_line_to(
-          pattern, coords_raw(i, j + 1, 0), coords_raw(i, j + 1, 1));
-        cairo_mesh_pattern_line_to(
-          pattern, coords_raw(i + 1, j + 1, 0), coords_raw(i + 1, j + 1, 1));
-        cairo_mesh_pattern_line_to(
-          pattern, coords_raw(i + 1, j, 0), coords_raw(i + 1, j, 1));
-        auto const& n = i * mesh_width + j;
-        auto const& r = fcs_raw(n, 0),
-                  & g = fcs_raw(n, 1),
-                  & b = fcs_raw(n, 2),
-                  & a = fcs_raw(n, 3);
-        for (auto k = 0; k < 4; ++k) {
-          cairo_mesh_pattern_set_corner_color_rgba(pattern, k, r, g, b, a);
-        }
-        cairo_mesh_pattern_end_patch(pattern);
+    for (auto const& [color, ns]: quads) {
+      cairo_new_path(cr_);
+      for (auto const& n: ns) {
+        auto const& i = n / mesh_width, j = n % mesh_width;
+        cairo_move_to(cr_, vx(i, j), vy(i, j));
+        cairo_line_to(cr_, vx(i, j + 1), vy(i, j + 1));
+        cairo_line_to(cr_, vx(i + 1, j + 1), vy(i + 1, j + 1));
+        cairo_line_to(cr_, vx(i + 1, j), vy(i + 1, j));
+        cairo_close_path(cr_);
       }
+      auto const& [r, g, b, a] = color;
+      cairo_set_source_rgba(cr_, r, g, b, a);
+      cairo_stroke(cr_);
     }
-    cairo_set_source(cr_, pattern);
-    cairo_pattern_destroy(pattern);
-    cairo_paint(cr_);
   }
 }
 
@@ -1732,9 +2564,19 @@ void MathtextBackend::draw(
       size * glyph.extend, 0, -size * glyph.slant * glyph.extend, size, 0, 0};
     cairo_set_font_matrix(cr, &mtx);
     adjust_font_options(cr, gcr.subpixel_antialiased_text_allowed_);
-    auto ft_face =
-      static_cast<FT_Face>(
-        cairo_font_face_get_user_data(face, &detail::FT_KEY));
+    // The FT_Face may be concurrently used by other threads, so access it
+    // while holding cairo's lock on it; the lock must be released before
+    // cairo_show_glyphs, which takes it again.
+    auto const& scaled_font = cairo_get_scaled_font(cr);
+    auto const& ft_face = cairo_ft_scaled_font_lock_face(scaled_font);
+    if (!ft_face) {
+      throw std::runtime_error{"failed to lock the font face"};
+    }
+    auto scaled_font_unlock_cleanup =
+      std::unique_ptr<
+        std::remove_pointer_t<cairo_scaled_font_t>,
+        decltype(&cairo_ft_scaled_font_unlock_face)>{
+          scaled_font, cairo_ft_scaled_font_unlock_face};
     auto index = std::visit(overloaded {
       [&](char32_t codepoint) {
         // The last unicode charmap is the FreeType-synthesized one.
@@ -1775,6 +2617,7 @@ void MathtextBackend::draw(
         return FT_Get_Char_Index(ft_face, idx);
       }
     }, glyph.codepoint_or_name_or_index);
+    scaled_font_unlock_cleanup.reset();
     if (!index) {
       auto glyph_ref = std::visit(overloaded {
         [&](char32_t codepoint) { return "#" + std::to_string(codepoint); },
@@ -1947,7 +2790,9 @@ cairo_circles : bool, default: True
     fixed spline approximation.
 
 collection_threads : int, default: 0
-    Number of threads to use to render markers and collections, if nonzero.
+    Number of threads to use to render markers, collections, long chunked
+    paths (see :rc:`agg.path.chunksize`), and (in horizontal bands) quadmeshes
+    and Gouraud-shaded triangles, if nonzero.
 
 image_format : format_t, default: ARGB32
     The internal image format (either a `format_t`, or the corresponding name).
@@ -1964,6 +2809,11 @@ miter_limit : float, default: 10
 raqm : bool, default: if available
     Whether to use Raqm for text rendering.
 
+stream_buffer_size : int, default: 262144
+    Size, in bytes, of the buffer used to coalesce the (many small) writes
+    emitted by vector surfaces before passing them to the output stream.  0
+    disables buffering.
+
 _debug: bool, default: False
     Whether to print debugging information.  This option is only intended for
     debugging and is not part of the stable API.
@@ -2133,6 +2983,7 @@ Only intended for debugging purposes.
     .value("EPS", mplcairo::StreamSurfaceType::EPS)
     .value("SVG", mplcairo::StreamSurfaceType::SVG)
     .value("Script", mplcairo::StreamSurfaceType::Script)
+    .value("Recording", mplcairo::StreamSurfaceType::Recording)
     .finalize();
 
   py::class_<Region>(m, "_Region", py::buffer_protocol())
@@ -2147,6 +2998,8 @@ Only intended for debugging purposes.
     .def(py::init<double, double, double>())
     .def(py::init<
          py::object, double, double, double, std::tuple<double, double>>())
+    // The filename overload must come first, as py::object matches anything.
+    .def(py::init<StreamSurfaceType, std::string, double, double, double>())
     .def(py::init<StreamSurfaceType, py::object, double, double, double>())
     .def(
       py::pickle(
@@ -2174,11 +3027,23 @@ Only intended for debugging purposes.
       })
     .def("_set_subpixel_antialiased_text_allowed",
          &GraphicsContextRenderer::_set_subpixel_antialiased_text_allowed)
+    .def(
+      "_set_image_magnification",
+      [](GraphicsContextRenderer& gcr, double magnification) -> void {
+        gcr.image_magnification_ = magnification;
+      })
+    .def(
+      "get_image_magnification",
+      [](GraphicsContextRenderer& gcr) -> double {
+        return gcr.image_magnification_;
+      })
     .def("_set_path", &GraphicsContextRenderer::_set_path)
     .def("_set_metadata", &GraphicsContextRenderer::_set_metadata)
     .def("_set_size", &GraphicsContextRenderer::_set_size)
     .def("_set_init_translation", &GraphicsContextRenderer::_set_init_translation)
     .def("_show_page", &GraphicsContextRenderer::_show_page)
+    .def("_flush_output", &GraphicsContextRenderer::_flush_output)
+    .def("_replay_onto", &GraphicsContextRenderer::_replay_onto)
     .def("_get_context", &GraphicsContextRenderer::_get_context)
     .def("_get_buffer", &GraphicsContextRenderer::_get_buffer)
     .def("_finish", &GraphicsContextRenderer::_finish)
@@ -2220,7 +3085,7 @@ Only intended for debugging purposes.
     .def(
       "get_clip_rectangle",
       [](GraphicsContextRenderer& gcr) -> std::optional<py::object> {
-        return gcr.get_additional_state().clip_rectangle;
+        return std::get<0>(gcr.get_additional_state().clip_rectangle);
       })
     .def(
       "get_clip_path",
@@ -2311,6 +3176,8 @@ Only intended for debugging purposes.
     .def("draw_image", &GraphicsContextRenderer::draw_image)
     .def("draw_path", &GraphicsContextRenderer::draw_path,
          "gc"_a, "path"_a, "transform"_a, "rgbFace"_a=nullptr)
+    .def("draw_paths_batched", &GraphicsContextRenderer::draw_paths_batched,
+         "gc"_a, "paths"_a, "transform"_a, "rgbFace"_a=nullptr)
     .def("draw_markers", &GraphicsContextRenderer::draw_markers,
          "gc"_a, "marker_path"_a, "marker_trans"_a, "path"_a, "trans"_a,
          "rgbFace"_a=nullptr)
@@ -7,7 +7,7 @@ namespace mplcairo {
 namespace py = pybind11;
 
 enum class StreamSurfaceType {
-  PDF, PS, EPS, SVG, Script
+  PDF, PS, EPS, SVG, Script, Recording
 };
 
 struct Region {
@@ -19,6 +19,42 @@ struct Region {
   py::bytes get_straight_argb32_bytes();
 };
 
+// Output of vector surfaces.  Coalesces the many small writes emitted by
+// cairo, and passes them either directly to the file descriptor underlying the
+// stream (for plain, seekable files) or to the stream's write method.
+class StreamWriter {
+  py::object file_;
+  py::object write_;  // None when writing to fd_.
+  int fd_ = -1;
+  size_t capacity_;
+  std::vector<unsigned char> buffer_;
+  size_t n_written_ = 0;
+  // The first write error, which is sticky (later writes are dropped) and
+  // reported by sync(): an errno (for fd_), a Python exception, or a short
+  // write.
+  int errno_ = 0;
+  std::optional<py::error_already_set> exception_ = {};
+  bool short_write_ = false;
+
+  bool failed() const;
+  bool write_through(unsigned char const* data, size_t length);
+
+  public:
+  StreamWriter(py::object file);
+  ~StreamWriter();
+  StreamWriter(StreamWriter const& other) = delete;
+  StreamWriter& operator=(StreamWriter const& other) = delete;
+
+  static cairo_status_t write(
+    void* closure, unsigned char const* data, unsigned int length);
+  static StreamWriter* get(cairo_surface_t* surface);
+  bool flush();
+  // Flush, raise any write error so far, and resynchronize the stream's
+  // position.
+  void sync();
+  size_t n_written() const;
+};
+
 py::object renderer_base(std::string meth_name);
 
 class GraphicsContextRenderer {
@@ -26,6 +62,8 @@ class GraphicsContextRenderer {
   cairo_t* const cr_;
   // Extents cannot be easily recovered from PDF/SVG surfaces, so record them.
   double width_, height_, dpi_;
+  // Resolution at which Matplotlib resamples images, relative to dpi_.
+  double image_magnification_ = 1;
   bool subpixel_antialiased_text_allowed_ = true;
 
   private:
@@ -47,6 +85,7 @@ class GraphicsContextRenderer {
 
   double pixels_to_points(double pixels);
   rgba_t get_rgba();
+  cairo_pattern_t* get_hatch_pattern();
 
   public:
 
@@ -62,12 +101,20 @@ class GraphicsContextRenderer {
     py::object ctx,
     double width, double height, double dpi,
     std::tuple<double, double> device_scales);
+  static cairo_t* cr_from_stream_surface(
+    StreamSurfaceType type, cairo_surface_t* surface, double dpi);
   static cairo_t* cr_from_fileformat_args(
     StreamSurfaceType type, py::object file,
     double width, double height, double dpi);
   GraphicsContextRenderer(
     StreamSurfaceType type, py::object file,
     double width, double height, double dpi);
+  static cairo_t* cr_from_fileformat_args(
+    StreamSurfaceType type, std::string filename,
+    double width, double height, double dpi);
+  GraphicsContextRenderer(
+    StreamSurfaceType type, std::string filename,
+    double width, double height, double dpi);
 
   static GraphicsContextRenderer make_pattern_gcr(cairo_surface_t* cr);
 
@@ -79,9 +126,11 @@ class GraphicsContextRenderer {
   void _set_size(double width, double height, double dpi);
   void _set_init_translation(double x, double y);
   void _show_page();
+  size_t _flush_output();
+  void _replay_onto(GraphicsContextRenderer& target);
   py::object _get_context();
   py::array _get_buffer();
-  void _finish();
+  size_t _finish();
 
   void set_alpha(std::optional<double> alpha);
   void set_antialiased(std::variant<cairo_antialias_t, bool> aa);
@@ -123,6 +172,11 @@ class GraphicsContextRenderer {
     py::object path,
     py::object transform,
     std::optional<py::object> fc);
+  void draw_paths_batched(
+    GraphicsContextRenderer& gc,
+    std::vector<py::object> paths,
+    py::object transform,
+    std::optional<py::object> fc);
   void draw_markers(
     GraphicsContextRenderer& gc,
     py::object marker_path,
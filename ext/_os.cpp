@@ -3,10 +3,15 @@
 #include <pybind11/pybind11.h>
 
 #if defined __linux__ || defined __APPLE__
+  #include <cerrno>
   #include <dlfcn.h>
   #include <execinfo.h>
   #include <signal.h>
+  #include <unistd.h>
 #elif defined _WIN32
+  #include <algorithm>
+  #include <io.h>
+  #include <limits>
   #include <memory>
   #define NOMINMAX
   #include <psapi.h>
@@ -49,6 +54,23 @@ std::string dladdr_fname(symbol_t handle)
     : "";
 }
 
+bool write_all(int fd, void const* data, size_t length)
+{
+  auto ptr = static_cast<char const*>(data);
+  while (length) {
+    auto const& n = ::write(fd, ptr, length);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    ptr += n;
+    length -= n;
+  }
+  return true;
+}
+
 void install_abrt_handler()
 {
   signal(SIGABRT, [](int signal) {
@@ -114,6 +136,23 @@ std::string dladdr_fname(symbol_t handle)
   return "";
 }
 
+bool write_all(int fd, void const* data, size_t length)
+{
+  auto ptr = static_cast<char const*>(data);
+  while (length) {
+    auto const& n = ::_write(
+      fd, ptr,
+      static_cast<unsigned int>(
+        std::min<size_t>(length, std::numeric_limits<int>::max())));
+    if (n < 0) {
+      return false;
+    }
+    ptr += n;
+    length -= n;
+  }
+  return true;
+}
+
 void install_abrt_handler()
 {
 }
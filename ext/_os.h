@@ -33,6 +33,9 @@ bool dlclose(library_t handle);
 symbol_t dlsym(library_t handle, char const* symbol);
 void throw_dlerror();
 std::string dladdr_fname(symbol_t handle);
+// Write all of data to fd, retrying on partial writes; false (with errno set)
+// on failure.
+bool write_all(int fd, void const* data, size_t length);
 
 void install_abrt_handler();
 
@@ -133,8 +133,17 @@ void PatternCache::mask(
       cairo_get_line_cap(cr), cairo_get_line_join(cr)};
   auto const& draw_direct = [&] {
     double r, g, b, a;
-    CAIRO_CHECK(cairo_pattern_get_rgba, cairo_get_source(cr), &r, &g, &b, &a);
-    key.draw(cr, x, y, {r, g, b, a});
+    if (cairo_pattern_get_rgba(cairo_get_source(cr), &r, &g, &b, &a)
+        == CAIRO_STATUS_SUCCESS) {
+      key.draw(cr, x, y, {r, g, b, a});
+    } else {
+      // Non-solid source (e.g., a hatch): mask it with the drawn path.
+      cairo_push_group_with_content(cr, CAIRO_CONTENT_ALPHA);
+      key.draw(cr, x, y);
+      auto const& mask = cairo_pop_group(cr);
+      cairo_mask(cr, mask);
+      cairo_pattern_destroy(mask);
+    }
   };
   if (!n_subpix_) {
     draw_direct();
@@ -169,9 +178,7 @@ void PatternCache::mask(
   auto const x_max = std::max(std::abs(bbox.x), std::abs(bbox.x + bbox.width)),
              y_max = std::max(std::abs(bbox.y), std::abs(bbox.y + bbox.height));
   if (x_max < threshold_ || y_max < threshold_) {
-    double r, g, b, a;
-    CAIRO_CHECK(cairo_pattern_get_rgba, cairo_get_source(cr), &r, &g, &b, &a);
-    key.draw(cr, x, y, {r, g, b, a});
+    draw_direct();
     return;
   }
   auto const& eps = threshold_ / 3,
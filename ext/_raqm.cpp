@@ -11,12 +11,34 @@ namespace mplcairo {
 namespace raqm {
 namespace {
 os::library_t _handle;
+// Incremented whenever raqm is loaded, so that pooled raqm_t's created by a
+// previously loaded raqm are never passed to the current one.
+unsigned _generation;
+
+struct Pool {
+  unsigned generation;
+  std::map<std::vector<std::string>, raqm_t*> contexts;
+
+  void clear() {
+    if (generation == _generation && _handle) {
+      for (auto const& [features, rq]: contexts) {
+        raqm::destroy(rq);
+      }
+    }  // Else, the raqm that created the contexts is gone; just leak them.
+    contexts.clear();
+  }
+
+  ~Pool() { clear(); }
+};
+
+thread_local Pool pool{};
 }
 }
 
 #define DEFINE_API(name) decltype(raqm_##name)* raqm::name{};
 ITER_RAQM_API(DEFINE_API)
 #undef DEFINE_API
+void (*raqm::clear_contents)(raqm_t*){};
 bool bad_color_glyph_spacing{};
 decltype(hb::version_string) hb::version_string{};
 
@@ -55,6 +77,12 @@ void load_raqm()
       }
     ITER_RAQM_API(LOAD_API)
     #undef LOAD_API
+    raqm::clear_contents = nullptr;
+    if (raqm::version_atleast(0, 9, 0)) {
+      raqm::clear_contents =
+        os::dlsym(raqm::_handle, "raqm_clear_contents");
+    }
+    ++raqm::_generation;
     // See text_to_glyphs_and_clusters for details.  Note that this should
     // really check the version of FreeType *that raqm was ./configure'd
     // against*, but that information is not available, so make do with what we
@@ -87,4 +115,34 @@ bool has_raqm()
   return raqm::_handle;
 }
 
+raqm_ptr make_raqm(std::vector<std::string> const& features)
+{
+  auto const& create = [&] {
+    auto rq = raqm_ptr{raqm::create(), raqm::destroy};
+    if (!rq) {
+      throw std::runtime_error{"failed to compute text layout"};
+    }
+    for (auto const& feature: features) {
+      TRUE_CHECK(raqm::add_font_feature, rq.get(), feature.c_str(), -1);
+    }
+    return rq;
+  };
+  if (!raqm::clear_contents) {
+    return create();
+  }
+  auto& pool = raqm::pool;
+  if (pool.generation != raqm::_generation) {
+    pool.clear();
+    pool.generation = raqm::_generation;
+  }
+  auto it = pool.contexts.find(features);
+  if (it == pool.contexts.end()) {
+    if (pool.contexts.size() >= 64) {  // Naive cache eviction.
+      pool.clear();
+    }
+    it = pool.contexts.emplace(features, create().release()).first;
+  }
+  return {it->second, raqm::clear_contents};
+}
+
 }
@@ -4,7 +4,11 @@ extern "C" {  // Support raqm<=0.2.
   #include <raqm.h>
 }
 
+#include <map>
+#include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 
 #define ITER_RAQM_API(_) \
   _(add_font_feature) \
@@ -29,11 +33,21 @@ namespace raqm {
 #define DECLARE_API(name) extern decltype(raqm_##name)* name;
 ITER_RAQM_API(DECLARE_API)
 #undef DECLARE_API
+// raqm>=0.9; nullptr if unavailable.
+extern void (*clear_contents)(raqm_t*);
 
 bool bad_color_glyph_spacing;
 
 }
 
+// A raqm_t with the given OpenType features set, and no contents.  If
+// raqm_clear_contents is available, raqm_t's are pooled per thread and keyed on
+// the features (which, unlike the text, font, and languages, survive clearing),
+// and the deleter merely clears them; otherwise, a new raqm_t is created every
+// time.
+using raqm_ptr = std::unique_ptr<raqm_t, void (*)(raqm_t*)>;
+raqm_ptr make_raqm(std::vector<std::string> const& features);
+
 namespace hb {
 
 extern char const* (*version_string)();
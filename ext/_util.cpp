@@ -54,6 +54,7 @@ ITER_CAIRO_OPTIONAL_API(DEFINE_API)
 
 // Other useful values.
 std::unordered_map<std::string, cairo_font_face_t*> FONT_CACHE{};
+std::mutex FONT_CACHE_MUTEX{}, FT_LIBRARY_MUTEX{};
 cairo_user_data_key_t const REFS_KEY{},
                             STATE_KEY{},
                             INIT_MATRIX_KEY{},
@@ -61,13 +62,18 @@ cairo_user_data_key_t const REFS_KEY{},
                             FEATURES_KEY{},
                             LANGS_KEY{},
                             VARIATIONS_KEY{},
-                            IS_COLOR_FONT_KEY{};
+                            IS_COLOR_FONT_KEY{},
+                            FONT_OPTIONS_KEY{},
+                            PATH_CACHE_KEY{},
+                            HATCH_CACHE_KEY{},
+                            STREAM_WRITER_KEY{};
 py::object RC_PARAMS{},
            PIXEL_MARKER{},
            UNIT_CIRCLE{};
 int COLLECTION_THREADS{};
 cairo_format_t IMAGE_FORMAT{CAIRO_FORMAT_ARGB32};
 double MITER_LIMIT{10.};
+size_t STREAM_BUFFER_SIZE{1 << 18};
 bool DEBUG{};
 MplcairoScriptSurface MPLCAIRO_SCRIPT_SURFACE{[] {
   if (auto script_surface = std::getenv("MPLCAIRO_SCRIPT_SURFACE")) {
@@ -101,6 +107,18 @@ GlyphsAndClusters::~GlyphsAndClusters() {
   cairo_text_cluster_free(clusters);
 }
 
+FontOptionsCache::~FontOptionsCache() {
+  for (auto const& options: this->options) {
+    cairo_font_options_destroy(options);  // Accepts nullptr.
+  }
+}
+
+PathCache::~PathCache() {
+  // The cairo_t may be destroyed without holding the GIL.
+  [[maybe_unused]] auto const& gil = py::gil_scoped_acquire{};
+  entries.clear();
+}
+
 py::object operator""_format(char const* fmt, std::size_t size) {
   return py::str(fmt, size).attr("format");
 }
@@ -117,6 +135,7 @@ py::dict get_options()
     "image_format"_a=detail::IMAGE_FORMAT,
     "miter_limit"_a=detail::MITER_LIMIT,
     "raqm"_a=has_raqm(),
+    "stream_buffer_size"_a=detail::STREAM_BUFFER_SIZE,
     "_debug"_a=detail::DEBUG);
 }
 
@@ -171,6 +190,9 @@ py::object set_options(py::kwargs kwargs)
       unload_raqm();
     }
   }
+  if (auto const& size = pop_option("stream_buffer_size", size_t{})) {
+    detail::STREAM_BUFFER_SIZE = *size;
+  }
   if (auto const& debug = pop_option("_debug", bool{})) {
     detail::DEBUG = *debug;
   }
@@ -314,13 +336,17 @@ struct LoadPathContext {
   double (*snapper)(double);
 
   public:
-  LoadPathContext(cairo_t* cr) :
+  // If append is set, the path is appended to the current path instead of
+  // replacing it.
+  LoadPathContext(cairo_t* cr, bool append) :
     cr{cr},
     snap{!has_vector_surface(cr) && get_additional_state(cr).snap}
   {
     cairo_get_matrix(cr, &ctm);
     restore_init_matrix(cr);
-    cairo_new_path(cr);
+    if (!append) {
+      cairo_new_path(cr);
+    }
     auto const& lw = cairo_get_line_width(cr);
     snapper =
       snap
@@ -342,12 +368,12 @@ struct LoadPathContext {
 
 // This overload implements the general case.
 void load_path_exact(
-  cairo_t* cr, py::handle path, cairo_matrix_t const* matrix)
+  cairo_t* cr, py::handle path, cairo_matrix_t const* matrix, bool append)
 {
   [[maybe_unused]] auto const& gil = py::gil_scoped_acquire{};
 
   auto const& min = double(-(1 << 22)), max = double(1 << 22);
-  auto const& lpc = LoadPathContext{cr};
+  auto const& lpc = LoadPathContext{cr, append};
 
   auto const& vertices_keepref =
     path.attr("vertices").cast<py::array_t<double>>();
@@ -360,7 +386,7 @@ void load_path_exact(
         path.attr("vertices")).cast<std::string>()};
   }
   if (!codes_keepref) {
-    load_path_exact(cr, vertices_keepref, 0, n, matrix);
+    load_path_exact(cr, vertices_keepref, 0, n, matrix, 0, append);
     return;
   }
   auto const& vertices = vertices_keepref.unchecked<2>();
@@ -370,8 +396,8 @@ void load_path_exact(
       "lengths of vertices ({}) and codes ({}) are mistached "_format(
         n, codes.shape(0)).cast<std::string>()};
   }
-  auto force_snap_next_lineto = bool{};
   auto const& snapper = lpc.snapper;
+  auto force_snap_next_lineto = bool{};
   // Main loop.
   for (auto i = 0; i < n; ++i) {
     auto x0 = vertices(i, 0), y0 = vertices(i, 1);
@@ -503,19 +529,190 @@ void load_path_exact(
   }
 }
 
+// Transform the `n` points at `data` (an array of doubles with byte strides
+// `stride0` and `stride1`) by `matrix`, into `xs` and `ys`.  This is written as
+// straight loops without function calls, so that the compiler can vectorize
+// them (at least in the common contiguous case).
+void transform_points(
+  cairo_matrix_t const* matrix, char const* data,
+  ssize_t n, ssize_t stride0, ssize_t stride1, double* xs, double* ys)
+{
+  auto const& [xx, yx, xy, yy, x0, y0] = *matrix;
+  if (stride0 == 2 * ssize_t(sizeof(double))
+      && stride1 == ssize_t(sizeof(double))) {
+    auto const& ptr = reinterpret_cast<double const*>(data);
+    for (auto i = ssize_t{}; i < n; ++i) {
+      auto const& x = ptr[2 * i], y = ptr[2 * i + 1];
+      // Same operation order as cairo_matrix_transform_point.
+      xs[i] = (xx * x + xy * y) + x0;
+      ys[i] = (yx * x + yy * y) + y0;
+    }
+  } else {
+    for (auto i = ssize_t{}; i < n; ++i) {
+      auto const& x = *reinterpret_cast<double const*>(data + i * stride0),
+                & y = *reinterpret_cast<double const*>(
+                    data + i * stride0 + stride1);
+      xs[i] = (xx * x + xy * y) + x0;
+      ys[i] = (yx * x + yy * y) + y0;
+    }
+  }
+}
+
+// Flags computed for each point by the codeless path loader.
+enum PointFlags : uint8_t {
+  OUT_LEFT = 1 << 0, OUT_RIGHT = 1 << 1, OUT_BOTTOM = 1 << 2, OUT_TOP = 1 << 3,
+  NONFINITE = 1 << 4, DROPPED = 1 << 5
+};
+
+// If the points of (xs, ys) in [start, stop) have monotonic x's and are much
+// denser than the pixel columns they span (e.g., long time series), mark all
+// of them as dropped except, for each pixel column, the first, the last, and
+// those with the minimum and maximum y's; this is visually equivalent to the
+// full path but makes its rasterization O(pixels) instead of O(points).
+// Return whether the decimation was performed.
+bool decimate_points(
+  double const* xs, double const* ys, uint8_t* flags,
+  ssize_t start, ssize_t stop)
+{
+  auto const& direction = xs[stop - 1] >= xs[start] ? 1 : -1;
+  for (auto i = start + 1; i < stop; ++i) {
+    if ((xs[i] - xs[i - 1]) * direction < 0) {
+      return false;
+    }
+  }
+  if (stop - start < 4 * (std::abs(xs[stop - 1] - xs[start]) + 1)) {
+    return false;  // Not worth it.
+  }
+  for (auto i = start; i < stop;) {
+    auto const& column = std::floor(xs[i]);
+    auto j = i, argmin = i, argmax = i;
+    for (; j < stop && std::floor(xs[j]) == column; ++j) {
+      if (ys[j] < ys[argmin]) {
+        argmin = j;
+      }
+      if (ys[j] > ys[argmax]) {
+        argmax = j;
+      }
+    }
+    for (auto k = i + 1; k < j - 1; ++k) {
+      if (k != argmin && k != argmax) {
+        flags[k] |= DROPPED;
+      }
+    }
+    i = j;
+  }
+  return true;
+}
+
+// Simplify, in screen space, the runs of finite points of (xs, ys), marking
+// the points to be dropped in flags.  If decimate is set, runs suitable for
+// min/max decimation are decimated (see decimate_points).  Otherwise, first,
+// points closer than threshold to the previously kept point are merged; then,
+// Douglas-Peucker is applied with the same tolerance, over windows of bounded
+// size (which bounds its quadratic worst case, while still keeping the
+// endpoints of each window).
+void simplify_points(
+  double const* xs, double const* ys, uint8_t* flags, ssize_t m,
+  double threshold, bool decimate)
+{
+  auto const& threshold2 = threshold * threshold;
+  auto const& window = ssize_t{4096};
+  auto kept = std::vector<ssize_t>{};
+  auto stack = std::vector<std::tuple<ssize_t, ssize_t>>{};
+  auto const& douglas_peucker = [&](ssize_t lo0, ssize_t hi0) {
+    // lo0 and hi0 index into kept.
+    stack.emplace_back(lo0, hi0);
+    while (!stack.empty()) {
+      auto const [lo, hi] = stack.back();
+      stack.pop_back();
+      if (hi - lo < 2) {
+        continue;
+      }
+      auto const& x0 = xs[kept[lo]], y0 = ys[kept[lo]],
+                & dx = xs[kept[hi]] - x0, dy = ys[kept[hi]] - y0;
+      auto const& norm2 = dx * dx + dy * dy;
+      auto max_dist2 = 0.;
+      auto argmax = lo;
+      for (auto k = lo + 1; k < hi; ++k) {
+        // Squared distance to the segment (not to the line, to handle
+        // backtracking).
+        auto px = xs[kept[k]] - x0, py = ys[kept[k]] - y0;
+        auto const& t =
+          norm2 ? std::clamp((px * dx + py * dy) / norm2, 0., 1.) : 0.;
+        px -= t * dx;
+        py -= t * dy;
+        if (auto const& dist2 = px * px + py * py; dist2 > max_dist2) {
+          max_dist2 = dist2;
+          argmax = k;
+        }
+      }
+      if (max_dist2 > threshold2) {
+        stack.emplace_back(lo, argmax);
+        stack.emplace_back(argmax, hi);
+      } else {
+        for (auto k = lo + 1; k < hi; ++k) {
+          flags[kept[k]] |= DROPPED;
+        }
+      }
+    }
+  };
+  for (auto start = ssize_t{}; start < m;) {
+    if (flags[start] & NONFINITE) {
+      ++start;
+      continue;
+    }
+    auto stop = start + 1;
+    while (stop < m && !(flags[stop] & NONFINITE)) {
+      ++stop;
+    }
+    if (decimate && decimate_points(xs, ys, flags, start, stop)) {
+      start = stop;
+      continue;
+    }
+    kept.clear();
+    kept.push_back(start);
+    for (auto i = start + 1; i < stop - 1; ++i) {
+      auto const& dx = xs[i] - xs[kept.back()], dy = ys[i] - ys[kept.back()];
+      if (dx * dx + dy * dy > threshold2) {
+        kept.push_back(i);
+      } else {
+        flags[i] |= DROPPED;
+      }
+    }
+    if (stop - 1 > start) {
+      kept.push_back(stop - 1);
+    }
+    for (auto lo = ssize_t{}; lo + 1 < ssize_t(kept.size()); lo += window) {
+      douglas_peucker(lo, std::min<ssize_t>(lo + window, kept.size() - 1));
+    }
+    start = stop;
+  }
+}
+
 // This overload implements the case of a codeless path.  Exposing start and
 // stop in the signature helps implementing support for agg.path.chunksize.
+//
+// The path is loaded in two passes: first, all points are transformed and
+// classified (finiteness and Cohen-Sutherland outcode) by vectorizable loops
+// (and optionally simplified, if simplify_threshold is nonzero); then, the
+// path data is assembled, with the (rare) segments that need clipping going
+// through the slow path.
 void load_path_exact(
   cairo_t* cr, py::array_t<double> vertices_keepref,
-  ssize_t start, ssize_t stop, cairo_matrix_t const* matrix)
+  ssize_t start, ssize_t stop, cairo_matrix_t const* matrix,
+  double simplify_threshold, bool append)
 {
   [[maybe_unused]] auto const& gil = py::gil_scoped_acquire{};
 
   auto const min = double(-(1 << 22)), max = double(1 << 22);
-  auto const& lpc = LoadPathContext{cr};
+  auto const& lpc = LoadPathContext{cr, append};
 
-  auto const& vertices = vertices_keepref.unchecked<2>();
-  auto const& n = vertices.shape(0);
+  auto const& n = vertices_keepref.shape(0);
+  if (vertices_keepref.ndim() != 2 || vertices_keepref.shape(1) != 2) {
+    throw std::invalid_argument{
+      "vertices must have shape (n, 2), not {.shape}"_format(
+        vertices_keepref).cast<std::string>()};
+  }
   if (!(0 <= start && start <= stop && stop <= n)) {
     throw std::invalid_argument{
       "invalid sub-path bounds ({}, {}) for path of size {}"_format(
@@ -523,114 +720,151 @@ void load_path_exact(
   }
   auto const& snapper = lpc.snapper;
 
+  auto const& m = stop - start;
+  auto xs = std::unique_ptr<double[]>{new double[m]},
+       ys = std::unique_ptr<double[]>{new double[m]};
+  auto codes = std::unique_ptr<uint8_t[]>{new uint8_t[m]};
+  // First pass: transformation and classification.
+  auto const& stride0 = vertices_keepref.strides(0),
+            & stride1 = vertices_keepref.strides(1);
+  transform_points(
+    matrix,
+    reinterpret_cast<char const*>(vertices_keepref.data()) + start * stride0,
+    m, stride0, stride1, xs.get(), ys.get());
+  for (auto i = ssize_t{}; i < m; ++i) {
+    auto const& x = xs[i], y = ys[i];
+    // Like isfinite(x) && isfinite(y), but branchless (x - x is NaN for
+    // infinite and NaN x).
+    auto const& finite = (x - x == 0) & (y - y == 0);
+    codes[i] =
+      (x < min) * OUT_LEFT | (x > max) * OUT_RIGHT
+      | (y < min) * OUT_BOTTOM | (y > max) * OUT_TOP
+      | !finite * NONFINITE;
+  }
+  if (simplify_threshold > 0) {
+    // Decimation would lose details when zooming into vector output, and
+    // would shift the dash pattern along dashed lines (which follows the
+    // length of the path).
+    simplify_points(
+      xs.get(), ys.get(), codes.get(), m, simplify_threshold,
+      !has_vector_surface(cr) && !cairo_get_dash_count(cr));
+  }
+  // Second pass: assembly.
   auto path_data = std::vector<cairo_path_data_t>{};
-  path_data.reserve(2 * (stop - start));
-  auto const LEFT = 1 << 0, RIGHT = 1 << 1, BOTTOM = 1 << 2, TOP = 1 << 3;
+  path_data.reserve(2 * m);
   auto const& outcode = [&](double x, double y) -> int {
     auto code = 0;
     if (x < min) {
-      code |= LEFT;
+      code |= OUT_LEFT;
     } else if (x > max) {
-      code |= RIGHT;
+      code |= OUT_RIGHT;
     }
     if (y < min) {
-      code |= BOTTOM;
+      code |= OUT_BOTTOM;
     } else if (y > max) {
-      code |= TOP;
+      code |= OUT_TOP;
     }
     return code;
   };
   // The previous point, if any, before clipping and snapping.
-  auto prev = std::optional<std::tuple<double, double>>{};
-  // Main loop.
-  for (auto i = start; i < stop; ++i) {
-    auto x = vertices(i, 0), y = vertices(i, 1);
-    cairo_matrix_transform_point(matrix, &x, &y);
-    if (std::isfinite(x) && std::isfinite(y)) {
-      cairo_path_data_t header, point;
-      if (prev) {
-        header.header = {CAIRO_PATH_LINE_TO, 2};
-        auto [x_prev, y_prev] = *prev;
-        prev = {x, y};
-        // Cohen-Sutherland clipping: we expect most segments to be within
-        // the 1 << 22 by 1 << 22 box.
-        auto code0 = outcode(x_prev, y_prev);
-        auto code1 = outcode(x, y);
-        auto accept = false, update_prev = false;
-        while (true) {
-          if (!(code0 | code1)) {
-            accept = true;
-            break;
-          } else if (code0 & code1) {
-            break;
-          } else {
-            auto xc = 0., yc = 0.;
-            auto code = code0 ? code0 : code1;
-            if (code & TOP) {
-              xc = x_prev + (x - x_prev) * (max - y_prev) / (y - y_prev);
-              yc = max;
-            } else if (code & BOTTOM) {
-              xc = x_prev + (x - x_prev) * (min - y_prev) / (y - y_prev);
-              yc = min;
-            } else if (code & RIGHT) {
-              yc = y_prev + (y - y_prev) * (max - x_prev) / (x - x_prev);
-              xc = max;
-            } else if (code & LEFT) {
-              yc = y_prev + (y - y_prev) * (min - x_prev) / (x - x_prev);
-              xc = min;
-            }
-            if (code == code0) {
-              update_prev = true;
-              x_prev = xc;
-              y_prev = yc;
-              code0 = outcode(x_prev, y_prev);
-            } else {
-              x = xc;
-              y = yc;
-              code1 = outcode(x, y);
-            }
-          }
-        }
-        if (accept) {
-          // If we accept the segment, but the previous point moved, record
-          // a MOVE_TO the new previous point (which will be followed by a
-          // LINE_TO the current point).
-          if (update_prev) {
-            cairo_path_data_t header_prev, point_prev;
-            header_prev.header = {CAIRO_PATH_MOVE_TO, 2};
-            point_prev.point = {x_prev, y_prev};
-            path_data.push_back(header_prev);
-            path_data.push_back(point_prev);
-          }
-        } else {
-          // If we don't accept the segment, still record a MOVE_TO the raw
-          // destination, as the next point may involve snapping.
-          header.header = {CAIRO_PATH_MOVE_TO, 2};
+  auto has_prev = false;
+  auto x_prev0 = 0., y_prev0 = 0.;
+  auto code_prev0 = 0;
+  for (auto i = ssize_t{}; i < m; ++i) {
+    auto x = xs[i], y = ys[i];
+    auto code1 = int(codes[i]);
+    if (code1 & DROPPED) {
+      continue;
+    }
+    if (code1 & NONFINITE) {
+      has_prev = false;
+      continue;
+    }
+    cairo_path_data_t header, point;
+    if (!has_prev) {
+      has_prev = true;
+      x_prev0 = x;
+      y_prev0 = y;
+      code_prev0 = code1;
+      header.header = {CAIRO_PATH_MOVE_TO, 2};
+      point.point = {x, y};
+      path_data.push_back(header);
+      path_data.push_back(point);
+      continue;
+    }
+    header.header = {CAIRO_PATH_LINE_TO, 2};
+    auto x_prev = x_prev0, y_prev = y_prev0;
+    auto code0 = code_prev0;
+    x_prev0 = x;
+    y_prev0 = y;
+    code_prev0 = code1;
+    // Cohen-Sutherland clipping: we expect most segments to be within the
+    // 1 << 22 by 1 << 22 box, in which case the segment is trivially accepted.
+    auto accept = false, update_prev = false;
+    while (true) {
+      if (!(code0 | code1)) {
+        accept = true;
+        break;
+      } else if (code0 & code1) {
+        break;
+      } else {
+        auto xc = 0., yc = 0.;
+        auto code = code0 ? code0 : code1;
+        if (code & OUT_TOP) {
+          xc = x_prev + (x - x_prev) * (max - y_prev) / (y - y_prev);
+          yc = max;
+        } else if (code & OUT_BOTTOM) {
+          xc = x_prev + (x - x_prev) * (min - y_prev) / (y - y_prev);
+          yc = min;
+        } else if (code & OUT_RIGHT) {
+          yc = y_prev + (y - y_prev) * (max - x_prev) / (x - x_prev);
+          xc = max;
+        } else if (code & OUT_LEFT) {
+          yc = y_prev + (y - y_prev) * (min - x_prev) / (x - x_prev);
+          xc = min;
         }
-        // Snapping.
-        if (lpc.snap && (x == x_prev || y == y_prev)) {
-          // If we have a horizontal or a vertical line, snap both coordinates.
-          // While it may make sense to only snap in the direction orthogonal
-          // to the displacement, this would cause e.g. axes spines to not line
-          // up properly, as they are drawn as independent segments.
-          path_data.back().point = {snapper(x_prev), snapper(y_prev)};
-          point.point = {snapper(x), snapper(y)};
+        if (code == code0) {
+          update_prev = true;
+          x_prev = xc;
+          y_prev = yc;
+          code0 = outcode(x_prev, y_prev);
         } else {
-          point.point = {x, y};
+          x = xc;
+          y = yc;
+          code1 = outcode(x, y);
         }
-        // Record the point.
-        path_data.push_back(header);
-        path_data.push_back(point);
-      } else {
-        prev = {x, y};
-        header.header = {CAIRO_PATH_MOVE_TO, 2};
-        point.point = {x, y};
-        path_data.push_back(header);
-        path_data.push_back(point);
       }
+    }
+    if (accept) {
+      // If we accept the segment, but the previous point moved, record a
+      // MOVE_TO the new previous point (which will be followed by a LINE_TO
+      // the current point).
+      if (update_prev) {
+        cairo_path_data_t header_prev, point_prev;
+        header_prev.header = {CAIRO_PATH_MOVE_TO, 2};
+        point_prev.point = {x_prev, y_prev};
+        path_data.push_back(header_prev);
+        path_data.push_back(point_prev);
+      }
+    } else {
+      // If we don't accept the segment, still record a MOVE_TO the raw
+      // destination, as the next point may involve snapping.
+      header.header = {CAIRO_PATH_MOVE_TO, 2};
+    }
+    // Snapping.
+    if (lpc.snap && (x == x_prev || y == y_prev)) {
+      // If we have a horizontal or a vertical line, snap both coordinates.
+      // While it may make sense to only snap in the direction orthogonal to
+      // the displacement, this would cause e.g. axes spines to not line up
+      // properly, as they are drawn as independent segments.
+      path_data.back().point = {snapper(x_prev), snapper(y_prev)};
+      point.point = {snapper(x), snapper(y)};
     } else {
-      prev = {};
+      point.point = {x, y};
     }
+    // Record the point.
+    path_data.push_back(header);
+    path_data.push_back(point);
   }
   auto const& path =
     cairo_path_t{
@@ -638,6 +872,119 @@ void load_path_exact(
   cairo_append_path(cr, &path);
 }
 
+// Like load_path_exact, but reuses the path loaded by a previous call with the
+// same vertices and codes arrays, transform, and snapping mode.  numpy arrays
+// carry no modification stamp, so only read-only arrays (e.g., those of
+// Path.unit_rectangle(), Path.unit_circle(), and markers) are cached; their
+// identity then fully determines their contents.
+void load_path_cached(
+  cairo_t* cr, py::handle path, cairo_matrix_t const* matrix)
+{
+  auto const& max_vertices = 1024;
+  auto const& max_entries = size_t{256};
+  auto const& vertices = path.attr("vertices");
+  auto const& codes = path.attr("codes");
+  auto const& is_cacheable = [](py::handle obj) {
+    return
+      py::isinstance<py::array>(obj)
+      && !py::reinterpret_borrow<py::array>(obj).writeable();
+  };
+  if (!is_cacheable(vertices)
+      || py::reinterpret_borrow<py::array>(vertices).size() > 2 * max_vertices
+      || !(codes.is_none() || is_cacheable(codes))) {
+    load_path_exact(cr, path, matrix);  // Also reports invalid paths.
+    return;
+  }
+  auto cache = static_cast<PathCache*>(
+    cairo_get_user_data(cr, &detail::PATH_CACHE_KEY));
+  if (!cache) {
+    cache = new PathCache{};
+    CAIRO_CHECK_SET_USER_DATA(
+      cairo_set_user_data, cr, &detail::PATH_CACHE_KEY,
+      cache, [](void* ptr) { delete static_cast<PathCache*>(ptr); });
+  }
+  // Must match the snapping mode selection in LoadPathContext.
+  auto const& lw = cairo_get_line_width(cr);
+  auto const& snap_mode =
+    has_vector_surface(cr) || !get_additional_state(cr).snap ? 0
+    : 0 < lw && (lw < 1 || std::lround(lw) % 2 == 1) ? 1
+    : 2;
+  auto const& key = std::tuple{
+    vertices.ptr(), codes.ptr(),
+    std::array<double, 6>{
+      matrix->xx, matrix->yx, matrix->xy, matrix->yy, matrix->x0, matrix->y0},
+    snap_mode};
+  cairo_matrix_t ctm;
+  cairo_get_matrix(cr, &ctm);
+  if (auto const& it = cache->entries.find(key);
+      it != cache->entries.end()) {
+    restore_init_matrix(cr);
+    cairo_new_path(cr);
+    cairo_append_path(cr, it->second.loaded.get());
+    cairo_set_matrix(cr, &ctm);
+    return;
+  }
+  load_path_exact(cr, path, matrix);
+  restore_init_matrix(cr);
+  auto loaded = std::unique_ptr<cairo_path_t, decltype(&cairo_path_destroy)>{
+    cairo_copy_path(cr), cairo_path_destroy};
+  cairo_set_matrix(cr, &ctm);
+  if (loaded->status != CAIRO_STATUS_SUCCESS) {
+    return;
+  }
+  if (cache->entries.size() >= max_entries) {
+    cache->entries.clear();
+  }
+  cache->entries.insert_or_assign(
+    key, PathCache::Entry{vertices, codes, std::move(loaded)});
+}
+
+// If `path`, after transformation by `matrix`, is an axis-aligned rectangle
+// (a MOVETO, three LINETOs, and a CLOSEPOLY), return its (x, y, width, height),
+// with nonnegative width and height.
+std::optional<rectangle_t> rectangle_extents(
+  py::handle path, cairo_matrix_t const* matrix)
+{
+  auto const& codes_keepref =
+    path.attr("codes").cast<std::optional<py::array_t<uint8_t>>>();
+  if (!codes_keepref || codes_keepref->ndim() != 1
+      || codes_keepref->shape(0) != 5) {
+    return {};
+  }
+  auto const& vertices_keepref =
+    path.attr("vertices").cast<py::array_t<double>>();
+  if (vertices_keepref.ndim() != 2
+      || vertices_keepref.shape(0) != 5 || vertices_keepref.shape(1) != 2) {
+    return {};
+  }
+  auto const& vertices = vertices_keepref.unchecked<2>();
+  auto const& codes = codes_keepref->unchecked<1>();
+  if (static_cast<PathCode>(codes(0)) != PathCode::MOVETO
+      || static_cast<PathCode>(codes(1)) != PathCode::LINETO
+      || static_cast<PathCode>(codes(2)) != PathCode::LINETO
+      || static_cast<PathCode>(codes(3)) != PathCode::LINETO
+      || static_cast<PathCode>(codes(4)) != PathCode::CLOSEPOLY) {
+    return {};
+  }
+  double xs[4], ys[4];
+  for (auto i = 0; i < 4; ++i) {
+    xs[i] = vertices(i, 0);
+    ys[i] = vertices(i, 1);
+    cairo_matrix_transform_point(matrix, &xs[i], &ys[i]);
+    if (!(std::isfinite(xs[i]) && std::isfinite(ys[i]))) {
+      return {};
+    }
+  }
+  if (!(xs[0] == xs[1] && ys[1] == ys[2] && xs[2] == xs[3] && ys[3] == ys[0])
+      && !(ys[0] == ys[1] && xs[1] == xs[2] && ys[2] == ys[3]
+           && xs[3] == xs[0])) {
+    return {};
+  }
+  return rectangle_t{
+    std::min(xs[0], xs[2]), std::min(ys[0], ys[2]),
+    std::abs(xs[2] - xs[0]), std::abs(ys[2] - ys[0])};
+}
+
 // Fill and/or stroke `path` onto `cr` after transformation by `matrix`,
 // ignoring the CTM ("exact").
 void fill_and_stroke_exact(
@@ -796,66 +1143,86 @@ auto parse_pathspec(std::string pathspec)
 
 cairo_font_face_t* font_face_from_path(std::string pathspec)
 {
-  auto& font_face = detail::FONT_CACHE[pathspec];
-  if (!font_face) {
-    auto parsed = parse_pathspec(pathspec);
-    FT_Face ft_face;
-    if (auto const& error =
-        FT_New_Face(
-          detail::ft_library, parsed.path.c_str(), parsed.face_index, &ft_face)) {
-      if (error == FT_Err_Cannot_Open_Resource) {
-        // Throw the exception that Python would throw...
-        py::module::import("builtins").attr("open")(parsed.path);
-        if (PyErr_Occurred()) {  // ... if possible.
-          throw py::error_already_set{};
-        }
+  {
+    auto const& lock = std::lock_guard{detail::FONT_CACHE_MUTEX};
+    if (auto const& it = detail::FONT_CACHE.find(pathspec);
+        it != detail::FONT_CACHE.end()) {
+      return cairo_font_face_reference(it->second);
+    }
+  }
+  // Create the font face without holding the lock (get_hinting_flag and error
+  // reporting call into Python, which may switch threads); if another thread
+  // inserted the same pathspec in the meantime, use its font face instead.
+  auto const& hinting_flag = get_hinting_flag();
+  auto parsed = parse_pathspec(pathspec);
+  FT_Face ft_face;
+  auto error = FT_Error{};
+  {
+    auto const& lock = std::lock_guard{detail::FT_LIBRARY_MUTEX};
+    error = FT_New_Face(
+      detail::ft_library, parsed.path.c_str(), parsed.face_index, &ft_face);
+  }
+  if (error) {
+    if (error == FT_Err_Cannot_Open_Resource) {
+      // Throw the exception that Python would throw...
+      py::module::import("builtins").attr("open")(parsed.path);
+      if (PyErr_Occurred()) {  // ... if possible.
+        throw py::error_already_set{};
       }
-      THROW_ERROR("FT_New_Face", mplcairo::detail::ft_errors.at(error));
     }
-    font_face =
-      cairo_ft_font_face_create_for_ft_face(ft_face, get_hinting_flag());
-    auto font_face_cleanup =  // In case set_user_data fails; released at end.
-      std::unique_ptr<
-        std::remove_pointer_t<cairo_font_face_t>,
-        decltype(&cairo_font_face_destroy)>{
-          font_face, cairo_font_face_destroy};
-    CAIRO_CHECK_SET_USER_DATA(
-      cairo_font_face_set_user_data, font_face, &detail::FT_KEY, ft_face,
-      [](void* ptr) { FT_CHECK(FT_Done_Face, reinterpret_cast<FT_Face>(ptr)); });
-    CAIRO_CHECK_SET_USER_DATA_NEW(
-      cairo_font_face_set_user_data, font_face, &detail::FEATURES_KEY,
-      parsed.features);
-    CAIRO_CHECK_SET_USER_DATA_NEW(
-      cairo_font_face_set_user_data, font_face, &detail::LANGS_KEY,
-      parsed.langs);
-    CAIRO_CHECK_SET_USER_DATA_NEW(
-      cairo_font_face_set_user_data, font_face, &detail::VARIATIONS_KEY,
-      parsed.variations);
-    // Color fonts need special handling due to cairo#404 and raqm#123; see
-    // corresponding sections of the code.
-    if (FT_IS_SFNT(ft_face)) {
-      auto n_tables = FT_ULong{}, table_length = FT_ULong{};
-      FT_CHECK(FT_Sfnt_Table_Info, ft_face, 0, nullptr, &n_tables);
-      for (auto i = FT_ULong{}; i < n_tables; ++i) {
-        auto tag = FT_ULong{};
-        FT_CHECK(
-          FT_Sfnt_Table_Info, ft_face, i, &tag, &table_length);
-        if (tag == FT_MAKE_TAG('C', 'O', 'L', 'R')
-            || tag == FT_MAKE_TAG('C', 'P', 'A', 'L')
-            || tag == FT_MAKE_TAG('C', 'B', 'D', 'T')
-            || tag == FT_MAKE_TAG('C', 'B', 'L', 'C')
-            || tag == FT_MAKE_TAG('s', 'b', 'i', 'x')
-            || tag == FT_MAKE_TAG('S', 'V', 'G', ' ')) {
-          CAIRO_CHECK_SET_USER_DATA(
-            cairo_font_face_set_user_data,
-            font_face, &detail::IS_COLOR_FONT_KEY, font_face, nullptr);
-          break;
-        }
+    THROW_ERROR("FT_New_Face", mplcairo::detail::ft_errors.at(error));
+  }
+  auto const& font_face =
+    cairo_ft_font_face_create_for_ft_face(ft_face, hinting_flag);
+  auto font_face_cleanup =  // In case set_user_data fails; released at end.
+    std::unique_ptr<
+      std::remove_pointer_t<cairo_font_face_t>,
+      decltype(&cairo_font_face_destroy)>{
+        font_face, cairo_font_face_destroy};
+  CAIRO_CHECK_SET_USER_DATA(
+    cairo_font_face_set_user_data, font_face, &detail::FT_KEY, ft_face,
+    [](void* ptr) {
+      auto const& lock = std::lock_guard{detail::FT_LIBRARY_MUTEX};
+      FT_CHECK(FT_Done_Face, reinterpret_cast<FT_Face>(ptr));
+    });
+  CAIRO_CHECK_SET_USER_DATA_NEW(
+    cairo_font_face_set_user_data, font_face, &detail::FEATURES_KEY,
+    parsed.features);
+  CAIRO_CHECK_SET_USER_DATA_NEW(
+    cairo_font_face_set_user_data, font_face, &detail::LANGS_KEY,
+    parsed.langs);
+  CAIRO_CHECK_SET_USER_DATA_NEW(
+    cairo_font_face_set_user_data, font_face, &detail::VARIATIONS_KEY,
+    parsed.variations);
+  // Color fonts need special handling due to cairo#404 and raqm#123; see
+  // corresponding sections of the code.
+  if (FT_IS_SFNT(ft_face)) {
+    auto n_tables = FT_ULong{}, table_length = FT_ULong{};
+    FT_CHECK(FT_Sfnt_Table_Info, ft_face, 0, nullptr, &n_tables);
+    for (auto i = FT_ULong{}; i < n_tables; ++i) {
+      auto tag = FT_ULong{};
+      FT_CHECK(
+        FT_Sfnt_Table_Info, ft_face, i, &tag, &table_length);
+      if (tag == FT_MAKE_TAG('C', 'O', 'L', 'R')
+          || tag == FT_MAKE_TAG('C', 'P', 'A', 'L')
+          || tag == FT_MAKE_TAG('C', 'B', 'D', 'T')
+          || tag == FT_MAKE_TAG('C', 'B', 'L', 'C')
+          || tag == FT_MAKE_TAG('s', 'b', 'i', 'x')
+          || tag == FT_MAKE_TAG('S', 'V', 'G', ' ')) {
+        CAIRO_CHECK_SET_USER_DATA(
+          cairo_font_face_set_user_data,
+          font_face, &detail::IS_COLOR_FONT_KEY, font_face, nullptr);
+        break;
       }
     }
-    font_face_cleanup.release();
   }
-  return cairo_font_face_reference(font_face);
+  auto const& lock = std::lock_guard{detail::FONT_CACHE_MUTEX};
+  auto const& [it, inserted] =
+    detail::FONT_CACHE.emplace(pathspec, font_face);
+  if (inserted) {
+    font_face_cleanup.release();
+  }  // Else, font_face_cleanup destroys the duplicate font face.
+  return cairo_font_face_reference(it->second);
 }
 
 cairo_font_face_t* font_face_from_path(py::object path) {
@@ -899,33 +1266,47 @@ long get_hinting_flag()
 void adjust_font_options(cairo_t* cr, bool subpixel_antialiased_text_allowed)
 {
   auto const& font_face = cairo_get_font_face(cr);
-  auto const& options = cairo_font_options_create();
+  auto aa = CAIRO_ANTIALIAS_DEFAULT;
   if (cairo_version() >= CAIRO_VERSION_ENCODE(1, 18, 0)
       // cairo#404 (<1.18.0): Don't set antialiasing for color fonts.
       || !cairo_font_face_get_user_data(font_face, &detail::IS_COLOR_FONT_KEY)) {
-    auto aa = rc_param("text.antialiased");  // Normally *exactly* a bool.
-    cairo_font_options_set_antialias(
-      options,
-      aa.ptr() == Py_True
+    auto const& aa_param = rc_param("text.antialiased");  // Normally a bool.
+    aa =
+      aa_param.ptr() == Py_True
       ? (subpixel_antialiased_text_allowed
          ? CAIRO_ANTIALIAS_SUBPIXEL : CAIRO_ANTIALIAS_GRAY)
-      : aa.ptr() == Py_False ? CAIRO_ANTIALIAS_NONE
-      : aa.cast<cairo_antialias_t>());
+      : aa_param.ptr() == Py_False ? CAIRO_ANTIALIAS_NONE
+      : aa_param.cast<cairo_antialias_t>();
   }
-  auto const& variations = *static_cast<std::string*>(
-    cairo_font_face_get_user_data(font_face, &detail::VARIATIONS_KEY));
-  if (!variations.empty()) {
-    if (detail::cairo_font_options_set_variations) {
-      detail::cairo_font_options_set_variations(options, variations.c_str());
-    } else {
-        py::module::import("warnings").attr("warn")(
-          "cairo_font_options_set_variations requires cairo>=1.16.0");
+  // As the cache is indexed by the antialiasing mode, changes to
+  // rcParams["text.antialiased"] are naturally taken into account.
+  auto cache = static_cast<FontOptionsCache*>(
+    cairo_font_face_get_user_data(font_face, &detail::FONT_OPTIONS_KEY));
+  if (!cache) {
+    cache = new FontOptionsCache{};
+    CAIRO_CHECK_SET_USER_DATA(
+      cairo_font_face_set_user_data, font_face, &detail::FONT_OPTIONS_KEY,
+      cache, [](void* ptr) { delete static_cast<FontOptionsCache*>(ptr); });
+  }
+  auto& options = cache->options.at(aa);
+  if (!options) {
+    options = cairo_font_options_create();
+    // Setting CAIRO_ANTIALIAS_DEFAULT is the same as not setting it.
+    cairo_font_options_set_antialias(options, aa);
+    auto const& variations = *static_cast<std::string*>(
+      cairo_font_face_get_user_data(font_face, &detail::VARIATIONS_KEY));
+    if (!variations.empty()) {
+      if (detail::cairo_font_options_set_variations) {
+        detail::cairo_font_options_set_variations(options, variations.c_str());
+      } else {
+          py::module::import("warnings").attr("warn")(
+            "cairo_font_options_set_variations requires cairo>=1.16.0");
+      }
     }
   }
   // The hint style is not set here: it is passed directly as load_flags to
   // cairo_ft_font_face_create_for_ft_face.
   cairo_set_font_options(cr, options);
-  cairo_font_options_destroy(options);
 }
 
 void warn_on_missing_glyph(std::string s)
@@ -952,21 +1333,15 @@ GlyphsAndClusters text_to_glyphs_and_clusters(cairo_t* cr, std::string s)
         std::remove_pointer_t<cairo_scaled_font_t>,
         decltype(&cairo_ft_scaled_font_unlock_face)>{
           scaled_font, cairo_ft_scaled_font_unlock_face};
-    auto const& rq = raqm::create();
-    [[maybe_unused]] auto const& rq_cleanup =
-      std::unique_ptr<std::remove_pointer_t<raqm_t>, decltype(raqm::destroy)>{
-        rq, raqm::destroy};
-    if (!rq) {
-      throw std::runtime_error{"failed to compute text layout"};
-    }
+    // The face must be set again for each string (it applies to a text
+    // range), but the features are set once per (pooled) raqm_t.
+    auto const& rq_ptr = make_raqm(
+      *static_cast<std::vector<std::string>*>(
+        cairo_font_face_get_user_data(
+          cairo_get_font_face(cr), &detail::FEATURES_KEY)));
+    auto const& rq = rq_ptr.get();
     TRUE_CHECK(raqm::set_text_utf8, rq, s.c_str(), s.size());
     TRUE_CHECK(raqm::set_freetype_face, rq, ft_face);
-    for (auto const& feature:
-         *static_cast<std::vector<std::string>*>(
-           cairo_font_face_get_user_data(
-             cairo_get_font_face(cr), &detail::FEATURES_KEY))) {
-      TRUE_CHECK(raqm::add_font_feature, rq, feature.c_str(), -1);
-    }
     for (auto const& [lang, start, stop]:
          *static_cast<std::vector<std::tuple<std::string, int, int>>*>(
            cairo_font_face_get_user_data(
@@ -7,6 +7,8 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <mutex>
+
 // Helper for std::visit.
 template<typename... Ts> struct overloaded : Ts... { using Ts::operator()...; };
 template<typename... Ts> overloaded(Ts...) -> overloaded<Ts...>;
@@ -91,23 +93,30 @@ extern void (*cairo_svg_surface_restrict_to_version)(
   _(cairo_font_options_set_variations) \
   _(cairo_pattern_set_dither) \
   _(cairo_pdf_get_versions) \
+  _(cairo_pdf_surface_create) \
   _(cairo_pdf_surface_create_for_stream) \
   _(cairo_pdf_surface_restrict_to_version) \
   _(cairo_pdf_surface_set_custom_metadata) \
   _(cairo_pdf_surface_set_metadata) \
   _(cairo_pdf_surface_set_size) \
   _(cairo_ps_get_levels) \
+  _(cairo_ps_surface_create) \
   _(cairo_ps_surface_create_for_stream) \
   _(cairo_ps_surface_dsc_comment) \
   _(cairo_ps_surface_restrict_to_level) \
   _(cairo_ps_surface_set_eps) \
   _(cairo_ps_surface_set_size) \
   _(cairo_svg_get_versions) \
+  _(cairo_svg_surface_create) \
   _(cairo_svg_surface_create_for_stream) \
   _(cairo_svg_surface_restrict_to_version)
 
 // Other useful values.
 extern std::unordered_map<std::string, cairo_font_face_t*> FONT_CACHE;
+// FONT_CACHE may be accessed from multiple threads; FT_Library is not
+// thread-safe for FT_New_Face/FT_Done_Face.  Accesses to FT_Faces themselves go
+// through cairo_ft_scaled_font_lock_face, which serializes them per face.
+extern std::mutex FONT_CACHE_MUTEX, FT_LIBRARY_MUTEX;
 extern cairo_user_data_key_t const
   REFS_KEY,           // cairo_t -> kept alive Python objects.
   STATE_KEY,          // cairo_t -> additional state.
@@ -116,13 +125,18 @@ extern cairo_user_data_key_t const
   FEATURES_KEY,       // cairo_font_face_t -> OpenType features.
   LANGS_KEY,          // cairo_font_face_t -> languages.
   VARIATIONS_KEY,     // cairo_font_face_t -> OpenType variations.
-  IS_COLOR_FONT_KEY;  // cairo_font_face_t -> non-null if a color font.
+  IS_COLOR_FONT_KEY,  // cairo_font_face_t -> non-null if a color font.
+  FONT_OPTIONS_KEY,   // cairo_font_face_t -> FontOptionsCache.
+  PATH_CACHE_KEY,     // cairo_t -> PathCache.
+  HATCH_CACHE_KEY,    // cairo_t -> HatchCache.
+  STREAM_WRITER_KEY;  // cairo_{surface,device}_t -> StreamWriter.
 extern py::object RC_PARAMS;
 extern py::object PIXEL_MARKER;
 extern py::object UNIT_CIRCLE;
 extern int COLLECTION_THREADS;
 extern cairo_format_t IMAGE_FORMAT;
 extern double MITER_LIMIT;
+extern size_t STREAM_BUFFER_SIZE;
 extern bool DEBUG;
 enum class MplcairoScriptSurface {
   None, Raster, Vector
@@ -141,7 +155,9 @@ enum class PathCode {
 struct AdditionalState {
   std::optional<double> alpha;
   std::variant<cairo_antialias_t, bool> antialias;
-  std::optional<py::object> clip_rectangle;
+  // The clip rectangle, and its bounds in device space.
+  std::tuple<std::optional<py::object>, std::optional<rectangle_t>>
+    clip_rectangle;
   std::tuple<std::optional<py::object>, std::shared_ptr<cairo_path_t>>
     clip_path;
   std::optional<std::string> hatch;
@@ -170,6 +186,42 @@ struct GlyphsAndClusters {
   ~GlyphsAndClusters();
 };
 
+// The font options depend only on the font face (via its variations and
+// whether it is a color font) and on the antialiasing mode, so we cache them on
+// the font face, indexed by the antialiasing mode.
+struct FontOptionsCache {
+  std::array<cairo_font_options_t*, CAIRO_ANTIALIAS_BEST + 1> options{};
+
+  ~FontOptionsCache();
+};
+
+// Loaded paths, for paths with read-only vertices and codes (which get redrawn
+// identically, e.g. background patches and markers), indexed by the vertices
+// and codes arrays, the transform, and the snapping mode.
+struct PathCache {
+  struct Entry {
+    // Kept alive so that their ids cannot get reused.
+    py::object vertices;
+    py::object codes;
+    std::unique_ptr<cairo_path_t, decltype(&cairo_path_destroy)> loaded;
+  };
+  std::map<
+    std::tuple<PyObject*, PyObject*, std::array<double, 6>, int>, Entry>
+    entries;
+
+  ~PathCache();
+};
+
+// Hatch patterns, indexed by the hatch, its color and linewidth, and the dpi
+// (the surface type is fixed for a given cairo_t).  Hatches that draw nothing
+// are recorded as null patterns.
+struct HatchCache {
+  std::map<
+    std::tuple<std::string, rgba_t, double, int>,
+    std::unique_ptr<cairo_pattern_t, decltype(&cairo_pattern_destroy)>>
+    patterns;
+};
+
 py::object operator""_format(char const* fmt, std::size_t size);
 bool py_eq(py::object obj1, py::object obj2);
 py::dict get_options();
@@ -182,11 +234,20 @@ cairo_matrix_t matrix_from_transform(
 bool has_vector_surface(cairo_t* cr);
 AdditionalState& get_additional_state(cairo_t* cr);
 void restore_init_matrix(cairo_t* cr);
+void transform_points(
+  cairo_matrix_t const* matrix, char const* data,
+  ssize_t n, ssize_t stride0, ssize_t stride1, double* xs, double* ys);
 void load_path_exact(
-  cairo_t* cr, py::handle path, cairo_matrix_t const* matrix);
+  cairo_t* cr, py::handle path, cairo_matrix_t const* matrix,
+  bool append = false);
 void load_path_exact(
   cairo_t* cr, py::array_t<double> vertices, ssize_t start, ssize_t stop,
-  cairo_matrix_t const* matrix);
+  cairo_matrix_t const* matrix, double simplify_threshold = 0,
+  bool append = false);
+void load_path_cached(
+  cairo_t* cr, py::handle path, cairo_matrix_t const* matrix);
+std::optional<rectangle_t> rectangle_extents(
+  py::handle path, cairo_matrix_t const* matrix);
 void fill_and_stroke_exact(
   cairo_t* cr, py::handle path, cairo_matrix_t const* matrix,
   std::optional<rgba_t> fill, std::optional<rgba_t> stroke);
@@ -0,0 +1,78 @@
+from matplotlib import colors as mcolors, lines as mlines
+from matplotlib.artist import Artist, allow_rasterization
+
+
+class PathBatch(Artist):
+    """
+    Many paths sharing the same style.
+
+    On mplcairo renderers, the paths are drawn with a single
+    ``draw_paths_batched`` call (avoiding the per-path overhead of
+    ``draw_path``); other renderers draw them one at a time.  Unfilled paths
+    are stroked together, so overlapping translucent strokes are composited
+    only once (dash patterns still restart at the start of each path).
+
+    Parameters
+    ----------
+    paths : list of `~matplotlib.path.Path`
+    edgecolor : color, default: "C0"
+    facecolor : color, optional
+        If not set, the paths are not filled.
+    linewidth : float, default: 1
+    linestyle : {"solid", "dashed", "dashdot", "dotted"} or (offset, dashes), \
+default: "solid"
+    capstyle : {"butt", "round", "projecting"}, optional
+    joinstyle : {"miter", "round", "bevel"}, optional
+        If not set, the renderer's defaults are used.
+    **kwargs
+        `.Artist` properties (e.g., *transform*, *alpha*, *clip_on*).
+    """
+
+    def __init__(self, paths, *,
+                 edgecolor="C0", facecolor=None, linewidth=1,
+                 linestyle="solid", capstyle=None, joinstyle=None, **kwargs):
+        super().__init__()
+        if capstyle not in [None, "butt", "round", "projecting"]:
+            raise ValueError(f"Invalid capstyle: {capstyle!r}")
+        if joinstyle not in [None, "miter", "round", "bevel"]:
+            raise ValueError(f"Invalid joinstyle: {joinstyle!r}")
+        self._paths = list(paths)
+        self._edgecolor = mcolors.to_rgba(edgecolor)
+        self._facecolor = (
+            mcolors.to_rgba(facecolor) if facecolor is not None else None)
+        self._linewidth = linewidth
+        self._dash_pattern = mlines._scale_dashes(
+            *mlines._get_dash_pattern(linestyle), linewidth)
+        self._capstyle = capstyle
+        self._joinstyle = joinstyle
+        self.update(kwargs)
+
+    def get_paths(self):
+        return self._paths
+
+    @allow_rasterization
+    def draw(self, renderer):
+        if not self.get_visible():
+            return
+        renderer.open_group("pathbatch", self.get_gid())
+        gc = renderer.new_gc()
+        self._set_gc_clip(gc)
+        gc.set_foreground(self._edgecolor, isRGBA=True)
+        gc.set_linewidth(self._linewidth)
+        gc.set_dashes(*self._dash_pattern)
+        if self._capstyle is not None:
+            gc.set_capstyle(self._capstyle)
+        if self._joinstyle is not None:
+            gc.set_joinstyle(self._joinstyle)
+        gc.set_alpha(self.get_alpha())
+        gc.set_url(self.get_url())
+        transform = self.get_transform()
+        draw_paths_batched = getattr(renderer, "draw_paths_batched", None)
+        if draw_paths_batched is not None:
+            draw_paths_batched(gc, self._paths, transform, self._facecolor)
+        else:
+            for path in self._paths:
+                renderer.draw_path(gc, path, transform, self._facecolor)
+        gc.restore()
+        renderer.close_group("pathbatch")
+        self.stale = False
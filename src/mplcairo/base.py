@@ -7,6 +7,7 @@ import logging
 import os
 from pathlib import Path
 import shutil
+import sys
 from tempfile import TemporaryDirectory
 from threading import RLock
 
@@ -26,7 +27,11 @@ from ._mplcairo import _StreamSurfaceType
 
 
 _log = logging.getLogger()
-_LOCK = RLock()  # FreeType2 is thread-unsafe.
+# Matplotlib's text layout, mathtext parser and font caches are not
+# thread-safe, so drawing is serialized (FreeType accesses are additionally
+# synchronized internally, as recordings can be replayed concurrently with
+# drawing; see multipage.MultiPage).  The rasterization itself releases the GIL.
+_LOCK = RLock()
 
 
 class _BytesWritingWrapper:
@@ -75,16 +80,29 @@ class GraphicsContextRendererCairo(
         return obj
 
     @classmethod
-    def _for_fmt_output(cls, fmt, stream, width, height, dpi):
-        if cbook.file_requires_unicode(stream):
-            if fmt in [_StreamSurfaceType.PS, _StreamSurfaceType.EPS]:
-                # PS is (typically) ASCII -- Language Reference, section 3.2.
-                stream = _BytesWritingWrapper(stream, "ascii")
-            elif fmt is _StreamSurfaceType.SVG:
-                # cairo outputs SVG with encoding="UTF-8".
-                stream = _BytesWritingWrapper(stream, "utf-8")
-            # (No default encoding for pdf, which is a binary format.)
-        args = fmt, stream, width, height, dpi
+    def _for_fmt_output(cls, fmt, path_or_stream, width, height, dpi):
+        if isinstance(path_or_stream, (str, os.PathLike)):
+            # Let cairo write directly to the file, bypassing Python (cairo
+            # expects UTF-8 filenames on Windows).
+            name = os.fsdecode(path_or_stream)
+            target = name if sys.platform == "win32" else os.fsencode(name)
+        else:
+            target = stream = path_or_stream
+            if cbook.file_requires_unicode(stream):
+                if fmt in [_StreamSurfaceType.PS, _StreamSurfaceType.EPS]:
+                    # PS is (typically) ASCII -- Language Reference, section
+                    # 3.2.
+                    target = _BytesWritingWrapper(stream, "ascii")
+                elif fmt is _StreamSurfaceType.SVG:
+                    # cairo outputs SVG with encoding="UTF-8".
+                    target = _BytesWritingWrapper(stream, "utf-8")
+                # (No default encoding for pdf, which is a binary format.)
+            try:
+                name = os.fsdecode(stream.name)
+            except (AttributeError, TypeError):
+                # In particular, stream.name is an int for TemporaryFile.
+                name = None
+        args = fmt, target, width, height, dpi
         cairo_debug_pdf = os.environ.get("CAIRO_DEBUG_PDF")
         if mpl.rcParams["pdf.compression"]:
             os.environ.setdefault("CAIRO_DEBUG_PDF", "1")
@@ -96,11 +114,7 @@ class GraphicsContextRendererCairo(
                 os.environ.pop("CAIRO_DEBUG_PDF", None)
             else:
                 os.environ["CAIRO_DEBUG_PDF"] = cairo_debug_pdf
-        try:
-            name = os.fsdecode(stream.name)
-        except (AttributeError, TypeError):
-            pass  # In particular, stream.name is an int for TemporaryFile.
-        else:
+        if name is not None:
             obj._set_path(name)
         RendererBase.__init__(obj)
         return obj
@@ -113,9 +127,24 @@ class GraphicsContextRendererCairo(
         _for_fmt_output, _StreamSurfaceType.Script)
 
     @classmethod
-    def _for_svgz_output(cls, stream, width, height, dpi):
-        gzip_file = GzipFile(fileobj=stream, mode="w")
-        obj = cls._for_svg_output(gzip_file, width, height, dpi)
+    def _for_recording_output(cls, width, height, dpi=72):
+        args = _StreamSurfaceType.Recording, None, width, height, dpi
+        obj = _mplcairo.GraphicsContextRendererCairo.__new__(cls, *args)
+        _mplcairo.GraphicsContextRendererCairo.__init__(obj, *args)
+        RendererBase.__init__(obj)
+        return obj
+
+    @classmethod
+    def _for_svgz_output(cls, path_or_stream, width, height, dpi):
+        # The output must go through GzipFile, so open paths here.
+        with contextlib.ExitStack() as stack:
+            if isinstance(path_or_stream, (str, os.PathLike)):
+                stream = stack.enter_context(open(path_or_stream, "wb"))
+            else:
+                stream = path_or_stream
+            gzip_file = GzipFile(fileobj=stream, mode="w")
+            obj = cls._for_svg_output(gzip_file, width, height, dpi)
+            owned = stack.pop_all()
         try:
             name = os.fsdecode(stream.name)
         except (AttributeError, TypeError):
@@ -124,8 +153,11 @@ class GraphicsContextRendererCairo(
             obj._set_path(name)
 
         def _finish():
-            cls._finish(obj)
-            gzip_file.close()
+            try:
+                cls._finish(obj)
+                gzip_file.close()
+            finally:
+                owned.close()
 
         obj._finish = _finish
         return obj
@@ -196,12 +228,38 @@ def _check_print_extra_kwargs(*,
     pass
 
 
+def _make_pnginfo(metadata):
+    metadata = {
+        "Software":
+        f"matplotlib version {get_versions()['matplotlib']}, "
+        f"https://matplotlib.org",
+        **(metadata if metadata is not None else {}),
+    }
+    # Only use the metadata kwarg if pnginfo is not set, because the semantics
+    # of duplicate keys in pnginfo is unclear.
+    pnginfo = PngInfo()
+    for k, v in metadata.items():
+        if v is not None:
+            pnginfo.add_text(k, v)
+    return pnginfo
+
+
 def _check_no_metadata(metadata):
     if metadata is not None:
         raise ValueError(  # Start of error string is forced by test.
             "metadata not supported for the requested output format")
 
 
+def _open_vector_output(path_or_stream):
+    # Paths are passed through to the renderer factories, which let cairo
+    # write the file directly -- except for .gz paths, which
+    # cbook.open_file_cm opens as gzip files.
+    if (isinstance(path_or_stream, (str, os.PathLike))
+            and not os.fsdecode(path_or_stream).endswith(".gz")):
+        return contextlib.nullcontext(path_or_stream)
+    return cbook.open_file_cm(path_or_stream, "wb")
+
+
 class FigureCanvasCairo(FigureCanvasBase):
     # Although this attribute should semantically be set from __init__ (it is
     # purely an instance attribute), initializing it at the class level helps
@@ -272,7 +330,7 @@ class FigureCanvasCairo(FigureCanvasBase):
         if _fixed_72dpi:
             self.figure.set_dpi(72)
         draw_raises_done = False
-        with cbook.open_file_cm(path_or_stream, "wb") as stream:
+        with _open_vector_output(path_or_stream) as stream:
             renderer = renderer_factory(stream, *self.figure.bbox.size, dpi)
             if _forced_size is not None:
                 renderer._set_size(*_forced_size, dpi)
@@ -404,20 +462,8 @@ class FigureCanvasCairo(FigureCanvasBase):
         img = self._get_fresh_straight_rgba8888()
         if dryrun:
             return
-        metadata = {
-            "Software":
-            f"matplotlib version {get_versions()['matplotlib']}, "
-            f"https://matplotlib.org",
-            **(metadata if metadata is not None else {}),
-        }
-        # Only use the metadata kwarg if pnginfo is not set, because the
-        # semantics of duplicate keys in pnginfo is unclear.
-        pnginfo = PngInfo()
-        for k, v in metadata.items():
-            if v is not None:
-                pnginfo.add_text(k, v)
         Image.fromarray(img).save(path_or_stream, format="png", **{
-            "pnginfo": pnginfo,
+            "pnginfo": _make_pnginfo(metadata),
             "dpi": (self.figure.dpi, self.figure.dpi),
             **(pil_kwargs if pil_kwargs is not None else {})})
 
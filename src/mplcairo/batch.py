@@ -0,0 +1,105 @@
+from collections import deque
+from concurrent.futures import ProcessPoolExecutor
+from io import BytesIO
+import os
+from pathlib import Path
+import pickle
+import sys
+
+import matplotlib as mpl
+from matplotlib.figure import Figure
+
+from . import set_options
+from .base import FigureCanvasCairo
+
+
+def _init_worker(options, rc):
+    set_options(**options or {})
+    mpl.rcParams.update(rc or {})
+    # Warm up the font caches (Matplotlib's font lookup, FreeType faces, and
+    # raqm), so that the first figure rendered by each worker is not
+    # penalized.
+    fig = Figure(figsize=(1, 1))
+    fig.text(.5, .5, "warmup")
+    FigureCanvasCairo(fig).draw()
+
+
+def _render(figure_or_factory, format, path, savefig_kwargs):
+    if isinstance(figure_or_factory, bytes):  # A pickled figure.
+        figure = pickle.loads(figure_or_factory)
+    elif isinstance(figure_or_factory, Figure):
+        figure = figure_or_factory
+    else:
+        figure = figure_or_factory()
+    FigureCanvasCairo(figure)
+    stream = BytesIO() if path is None else path
+    figure.savefig(stream, format=format, **savefig_kwargs)
+    if "matplotlib.pyplot" in sys.modules:  # Close figures from pyplot.
+        sys.modules["matplotlib.pyplot"].close(figure)
+    return stream.getvalue() if path is None else path
+
+
+def render(figures, format="png", *, output_dir=None, processes=None,
+           options=None, rc=None, savefig_kwargs=None):
+    """
+    Render figures across a pool of worker processes.
+
+    Parameters
+    ----------
+    figures : iterable
+        Each item is either a picklable callable taking no arguments and
+        returning a `.Figure` (a figure factory, e.g. a module-level
+        function), a `.Figure` (which gets pickled to be sent to a worker),
+        or an already pickled `.Figure` (as `bytes`).
+    format : str, default: "png"
+        The output format, e.g. "png" or "pdf".
+    output_dir : path-like, optional
+        If given, the *i*-th figure is saved by the worker to
+        ``output_dir / f"{i}.{format}"``, and that path is yielded.
+        Otherwise, the rendered bytes are yielded.
+    processes : int, optional
+        The number of worker processes; defaults to the number of CPUs.
+    options : dict, optional
+        Options passed to `.set_options` in each worker, once.
+    rc : dict, optional
+        rcParams set in each worker, once (workers otherwise start with the
+        rcParams inherited from the parent process if forked, or the default
+        ones if spawned).
+    savefig_kwargs : dict, optional
+        Additional keyword arguments passed to `.Figure.savefig`.
+
+    Yields
+    ------
+    bytes or Path
+        The rendered figures (or the paths they have been saved to), in the
+        order of *figures*, as they become available.  At most twice as many
+        figures as *processes* are submitted to the workers ahead of the one
+        being yielded, so that the (pickled) figures and their results are not
+        all held in memory at once.
+    """
+    if output_dir is not None:
+        output_dir = Path(output_dir)
+        output_dir.mkdir(parents=True, exist_ok=True)
+    savefig_kwargs = savefig_kwargs or {}
+    processes = processes or os.cpu_count() or 1
+    window = 2 * processes
+    executor = ProcessPoolExecutor(
+        processes, initializer=_init_worker, initargs=(options, rc))
+    pending = deque()
+    with executor:
+        try:
+            for i, figure_or_factory in enumerate(figures):
+                pending.append(executor.submit(
+                    _render, figure_or_factory, format,
+                    None if output_dir is None
+                    else output_dir / f"{i}.{format}",
+                    savefig_kwargs))
+                if len(pending) == window:
+                    yield pending.popleft().result()
+            while pending:
+                yield pending.popleft().result()
+        finally:
+            # If the generator is abandoned (or a figure fails), don't render
+            # the figures that have not started yet.
+            for future in pending:
+                future.cancel()
@@ -1,10 +1,20 @@
+from collections import deque, namedtuple
+from concurrent.futures import ThreadPoolExecutor
 from contextlib import ExitStack
 import copy
 from pathlib import Path
+import time
 
 from matplotlib import cbook, rcParams
 
-from .base import GraphicsContextRendererCairo, _LOCK
+from .base import GraphicsContextRendererCairo
+from .recording import Recording
+
+
+PageStats = namedtuple("PageStats", ["draw_time", "write_time", "nbytes"])
+PageStats.__doc__ = """
+Drawing and writing times (in seconds), and size (in bytes), of an output page.
+"""
 
 
 class MultiPage:
@@ -20,14 +30,50 @@ class MultiPage:
     Note that the only other method of `PdfPages` that is implemented is
     `close`, and that empty files are not created -- as if the *keep_empty*
     argument to `PdfPages` was always False.
+
+    Each figure passed to `savefig` is drawn (by the calling thread) into a
+    recording (see `.Recording`, with images resampled at 72 dpi), which is
+    then written to the output.  If *background* is True, the recordings are
+    written by a background thread (in page order), while the next pages are
+    drawn; the output is identical either way.  At most *window* pages (default: 2) are kept in memory
+    waiting to be written; `savefig` blocks until older pages are written if
+    needed.  As figures are fully drawn by `savefig`, they can be modified (or
+    reused) as soon as it returns.  Matplotlib code (drawing) never runs on
+    the background thread; only the writing does, mostly without the GIL.
+
+    If *stats* is True, each page is flushed to the output as soon as it is
+    shown, and the `PageStats` of each written page are appended to the
+    ``page_stats`` attribute (and, if the page is written immediately, i.e.
+    without *background*, returned by `savefig`).  The page sizes add up to
+    the size of the output: the first page's includes the document header,
+    and the last page's the data written when the document is finished (e.g.,
+    embedded fonts, cross-reference tables).
+
+    Note that memory use still grows with the number of pages, whether or
+    not *stats* and *background* are set: cairo keeps per-document state (in
+    particular, font subsets, object tables, and references to the replayed
+    recordings) until the document is finished, and ``page_stats`` gets one
+    entry per page.  Bounding it would require splitting the output into
+    several documents.
     """
 
-    def __init__(self, path_or_stream=None, format=None, *, metadata=None):
+    def __init__(self, path_or_stream=None, format=None, *, metadata=None,
+                 background=False, window=None, stats=False):
         self._stack = ExitStack()
         self._renderer = None
+        self._stream = None
+        self._stats = stats
+        self._nbytes = 0
+        self.page_stats = []
+        self._executor = None
+        self._pending = deque()  # Futures of pages being written.
+        if background:
+            # A single thread, so that pages are written in order.
+            self._executor = self._stack.enter_context(ThreadPoolExecutor(1))
+            self._window = max(window if window is not None else 2, 1)
 
         def _make_renderer():
-            stream = self._stack.enter_context(
+            stream = self._stream = self._stack.enter_context(
                 cbook.open_file_cm(path_or_stream, "wb"))
             fmt = (format
                    or Path(getattr(stream, "name", "")).suffix[1:]
@@ -37,7 +83,9 @@ class MultiPage:
                 "ps": GraphicsContextRendererCairo._for_ps_output,
             }[fmt]
             self._renderer = renderer_cls(stream, 1, 1, 1)
-            self._stack.callback(self._renderer._finish)
+            self._stack.callback(self._finish)
+            # Pending pages must be written before finishing.
+            self._stack.callback(self._drain)
             self._renderer._set_metadata(copy.copy(metadata))
 
         self._make_renderer = _make_renderer
@@ -47,12 +95,49 @@ class MultiPage:
         # deprecate them upstream.
         if self._renderer is None:
             self._make_renderer()
-        figure.set_dpi(72)
-        self._renderer._set_size(*figure.canvas.get_width_height(),
-                                 kwargs.get("dpi", 72))
-        with _LOCK:
-            figure.draw(self._renderer)
+        dpi = kwargs.get("dpi", 72)
+        # Both paths go through a recording, so that their outputs are
+        # identical.
+        start = time.perf_counter()
+        recording = Recording(figure, image_dpi=72, _renderer_dpi=dpi)
+        draw_time = time.perf_counter() - start
+        if self._executor is not None:
+            self._pending.append(self._executor.submit(
+                self._write_recording, recording, draw_time, dpi))
+            while len(self._pending) > self._window:
+                self._pending.popleft().result()
+            return
+        return self._write_recording(recording, draw_time, dpi)
+
+    def _write_recording(self, recording, draw_time, dpi):
+        # Sized to the recording, so the replay is not scaled.
+        start = time.perf_counter()
+        self._renderer._set_size(*recording._size, dpi)
+        recording._renderer._replay_onto(self._renderer)
+        return self._show_page(draw_time, start)
+
+    def _show_page(self, draw_time, write_start):
         self._renderer._show_page()
+        if not self._stats:
+            return None
+        nbytes = self._renderer._flush_output()
+        self._stream.flush()
+        stats = PageStats(
+            draw_time, time.perf_counter() - write_start, nbytes - self._nbytes)
+        self._nbytes = nbytes
+        self.page_stats.append(stats)
+        return stats
+
+    def _finish(self):
+        nbytes = self._renderer._finish()
+        if self._stats and self.page_stats:
+            self.page_stats[-1] = self.page_stats[-1]._replace(
+                nbytes=self.page_stats[-1].nbytes + nbytes - self._nbytes)
+            self._nbytes = nbytes
+
+    def _drain(self):
+        while self._pending:
+            self._pending.popleft().result()
 
     def close(self):
         return self._stack.__exit__(None, None, None)
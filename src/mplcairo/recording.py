@@ -0,0 +1,136 @@
+import os
+from pathlib import Path
+
+from PIL import Image
+
+from matplotlib import cbook, rcParams
+
+from . import _mplcairo
+from .base import (
+    GraphicsContextRendererCairo, _LOCK, _check_no_metadata, _make_pnginfo,
+    _open_vector_output)
+
+
+_VECTOR_FACTORIES = {
+    "pdf": GraphicsContextRendererCairo._for_pdf_output,
+    "ps": GraphicsContextRendererCairo._for_ps_output,
+    "eps": GraphicsContextRendererCairo._for_eps_output,
+    "svg": GraphicsContextRendererCairo._for_svg_output,
+    "svgz": GraphicsContextRendererCairo._for_svgz_output,
+}
+_RASTER_FORMATS = {
+    "png": "png", "tif": "tiff", "tiff": "tiff", "webp": "webp",
+}
+
+
+class Recording:
+    """
+    A figure, drawn once into a cairo recording surface.
+
+    The recording can then be saved to any number of outputs (raster outputs
+    at various dpis, PDF, PS, SVG), without drawing the figure again::
+
+        rec = Recording(fig, image_dpi=200)
+        rec.savefig("fig.pdf")
+        rec.savefig("fig.svg")
+        rec.savefig("fig.png", dpi=200)
+
+    The figure is drawn as for vector output, with images resampled by
+    Matplotlib at *image_dpi* (default: the figure's dpi).  Hence, raster
+    outputs are approximations of directly saving the figure to the same
+    format: they are not pixel-identical, as drawing for raster output snaps
+    lines to pixels and stamps markers, and images are scaled from
+    *image_dpi* to the output dpi.
+
+    Later changes to the figure are not reflected in the recording.  Only the
+    *format*, *dpi*, *metadata*, and *pil_kwargs* arguments of
+    `.Figure.savefig` are supported; in particular, PS output is sized to the
+    figure (as if *papertype* was "figure").
+    """
+
+    def __init__(self, figure, *, image_dpi=None, _renderer_dpi=72):
+        # _renderer_dpi is the dpi reported to artists (e.g., to convert
+        # linewidths), which MultiPage sets to the page's dpi.
+        self._dpi = figure.dpi
+        if image_dpi is None:
+            image_dpi = self._dpi
+        figure.set_dpi(72)
+        try:
+            self._size = tuple(figure.bbox.size)
+            self._renderer = (
+                GraphicsContextRendererCairo._for_recording_output(
+                    *self._size, _renderer_dpi))
+            self._renderer._set_image_magnification(image_dpi / 72)
+            with _LOCK:
+                figure.draw(self._renderer)
+        finally:
+            figure.set_dpi(self._dpi)
+
+    def savefig(self, path_or_stream, format=None, *,
+                dpi=None, metadata=None, pil_kwargs=None):
+        """
+        Save the recording.
+
+        Parameters
+        ----------
+        path_or_stream : path-like or file-like
+        format : str, optional
+            The output format; defaults to the extension of *path_or_stream*
+            if any, and to :rc:`savefig.format` otherwise.
+        dpi : float, optional
+            The output resolution (for vector outputs, the resolution of
+            rasterized fallbacks); defaults to the figure's dpi at the time of
+            the recording.
+        metadata : dict, optional
+            As for `.Figure.savefig`.
+        pil_kwargs : dict, optional
+            Additional keyword arguments passed to `PIL.Image.Image.save`, for
+            raster formats other than rgba.
+        """
+        if format is None:
+            name = (path_or_stream
+                    if isinstance(path_or_stream, (str, os.PathLike))
+                    else getattr(path_or_stream, "name", ""))
+            format = (Path(os.fsdecode(name)).suffix[1:]
+                      if isinstance(name, (str, bytes, os.PathLike)) else "")
+            format = format or rcParams["savefig.format"]
+        format = format.lower()
+        if dpi is None:
+            dpi = self._dpi
+        if format in _VECTOR_FACTORIES:
+            if pil_kwargs is not None:
+                raise ValueError(
+                    f"pil_kwargs not supported for format {format!r}")
+            with _open_vector_output(path_or_stream) as stream:
+                renderer = _VECTOR_FACTORIES[format](
+                    stream, *self._size, dpi)
+                try:
+                    renderer._set_metadata(metadata)
+                    self._renderer._replay_onto(renderer)
+                finally:
+                    renderer._finish()
+        elif format in ["rgba", "raw", *_RASTER_FORMATS]:
+            width, height = self._size
+            renderer = GraphicsContextRendererCairo(
+                round(width * dpi / 72), round(height * dpi / 72), dpi)
+            self._renderer._replay_onto(renderer)
+            img = _mplcairo.cairo_to_straight_rgba8888(renderer._get_buffer())
+            if format in ["rgba", "raw"]:
+                _check_no_metadata(metadata)
+                if pil_kwargs is not None:
+                    raise ValueError(
+                        f"pil_kwargs not supported for format {format!r}")
+                with cbook.open_file_cm(path_or_stream, "wb") as stream:
+                    stream.write(img.tobytes())
+            else:
+                kwargs = {"dpi": (dpi, dpi)}
+                if format == "png":
+                    kwargs["pnginfo"] = _make_pnginfo(metadata)
+                else:
+                    _check_no_metadata(metadata)
+                Image.fromarray(img).save(
+                    path_or_stream, format=_RASTER_FORMATS[format],
+                    **{**kwargs,
+                       **(pil_kwargs if pil_kwargs is not None else {})})
+        else:
+            raise ValueError(f"Unsupported format: {format!r}")
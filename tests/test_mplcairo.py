@@ -0,0 +1,333 @@
+from collections import Counter
+from concurrent.futures import ThreadPoolExecutor
+import gzip
+from io import BytesIO
+import re
+import threading
+
+import numpy as np
+from PIL import Image
+import pytest
+
+import matplotlib as mpl
+from matplotlib.figure import Figure
+from matplotlib.patches import PathPatch
+from matplotlib.path import Path
+
+import mplcairo
+from mplcairo import batch
+from mplcairo.artists import PathBatch
+from mplcairo.base import FigureCanvasCairo, GraphicsContextRendererCairo
+from mplcairo.multipage import MultiPage
+from mplcairo.recording import Recording
+
+# Import an autouse fixture.
+from matplotlib.testing.conftest import mpl_test_settings
+
+
+def _render(fig):
+    canvas = FigureCanvasCairo(fig)
+    canvas.draw()
+    return np.asarray(canvas.buffer_rgba()).copy()
+
+
+def _text_figure(k):
+    fig = Figure(figsize=(2, 2))
+    fig.text(.1, .7, f"text {k}", size=12 + k, family="DejaVu Sans")
+    fig.text(.1, .4, rf"$\sum_{{i={k}}}^\infty \frac{{x^i}}{{\sqrt{{i}}}}$",
+             size=12 + k)
+    fig.text(.1, .1, f"serif {k}", size=10 + k, family="DejaVu Serif",
+             rotation=10 * k)
+    return fig
+
+
+def test_concurrent_text_drawing():
+    # Drawing is serialized by a global lock, but threads still interleave
+    # outside of it (e.g., while replaying recordings or copying buffers).
+    n = 8
+    serial = [_render(_text_figure(k)) for k in range(n)]
+    barrier = threading.Barrier(n)
+
+    def render(k):
+        fig = _text_figure(k)
+        barrier.wait()  # Maximize overlap.
+        return [_render(fig) for _ in range(3)]
+
+    with ThreadPoolExecutor(n) as executor:
+        results = list(executor.map(render, range(n)))
+    for expected, imgs in zip(serial, results):
+        for img in imgs:
+            np.testing.assert_array_equal(img, expected)
+
+
+def test_draw_paths_batched_matches_draw_path(monkeypatch):
+    # Overlapping squares, with opposite orientations, filled with alpha.
+    paths = [
+        Path([(.1, .1), (.6, .1), (.6, .6), (.1, .6), (.1, .1)], closed=True),
+        Path([(.4, .4), (.4, .9), (.9, .9), (.9, .4), (.4, .4)], closed=True),
+    ]
+
+    def render():
+        fig = Figure(figsize=(2, 2))
+        fig.add_artist(PathBatch(
+            paths, edgecolor=(1, 0, 0, .5), facecolor=(0, 0, 1, .5),
+            linewidth=3, transform=fig.transFigure))
+        return _render(fig)
+
+    batched = render()
+    # Fall back to individual draw_path calls.
+    monkeypatch.setattr(
+        GraphicsContextRendererCairo, "draw_paths_batched", None,
+        raising=False)
+    np.testing.assert_array_equal(render(), batched)
+
+
+@pytest.mark.parametrize("linestyle", ["solid", "dashed"])
+def test_draw_paths_batched_stroke_matches_draw_path(monkeypatch, linestyle):
+    # Non-overlapping (as overlapping strokes are composited only once when
+    # batched) translucent zigzags, the middle one being longer than the
+    # chunksize (and thus drawn by draw_path even when batching).
+    def zigzag(y, n):
+        x = np.linspace(.1, .9, n)
+        return Path(np.column_stack([x, y + .02 * (-1) ** np.arange(n)]))
+
+    paths = [zigzag(.2, 10), zigzag(.5, 200), zigzag(.8, 10)]
+
+    def render():
+        fig = Figure(figsize=(2, 2))
+        fig.add_artist(PathBatch(
+            paths, edgecolor=(1, 0, 0, .5), linewidth=3, linestyle=linestyle,
+            capstyle="round", joinstyle="bevel", transform=fig.transFigure))
+        return _render(fig)
+
+    with mpl.rc_context({"agg.path.chunksize": 50}):
+        batched = render()
+        monkeypatch.setattr(
+            GraphicsContextRendererCairo, "draw_paths_batched", None,
+            raising=False)
+        np.testing.assert_array_equal(render(), batched)
+
+
+def test_path_batch_invalid_style():
+    with pytest.raises(ValueError):
+        PathBatch([], capstyle="square")
+    with pytest.raises(ValueError):
+        PathBatch([], joinstyle="sharp")
+
+def test_rectangle_fast_path_matches_path():
+    # Edgeless rectangles at fractional positions; codeless paths do not go
+    # through the rectangle fast path.
+    def render(codes):
+        fig = Figure(figsize=(2, 2), dpi=50)
+        for i, x in enumerate(np.linspace(.1, .7, 7)):
+            top = .3 + .09 * i
+            fig.add_artist(PathPatch(
+                Path([(x, .13), (x + .07, .13), (x + .07, top), (x, top),
+                      (x, .13)], codes),
+                facecolor=f"C{i}", alpha=.7, linewidth=0))
+        return _render(fig)
+
+    np.testing.assert_array_equal(
+        render([Path.MOVETO, *[Path.LINETO] * 3, Path.CLOSEPOLY]),
+        render(None))
+
+def test_stream_write_error_is_reported():
+    class FullStream:
+        def write(self, data):
+            if len(data):  # Not the probe by cbook.file_requires_unicode.
+                raise OSError(28, "No space left on device")
+            return 0
+
+    fig = Figure()
+    fig.subplots().plot([0, 1])
+    FigureCanvasCairo(fig)
+    with pytest.raises(OSError):
+        fig.savefig(FullStream(), format="pdf")
+
+
+@pytest.mark.parametrize("format, magic", [
+    ("pdf", b"%PDF"),
+    ("ps", b"%!PS"),
+    ("svg", b"<?xml"),
+])
+def test_vector_path_output(tmp_path, format, magic):
+    fig = _sample_figure()
+    FigureCanvasCairo(fig)
+    fig.savefig(tmp_path / f"out.{format}")
+    assert (tmp_path / f"out.{format}").read_bytes().startswith(magic)
+    # .gz paths are still compressed.
+    fig.savefig(tmp_path / f"out.{format}.gz", format=format)
+    assert gzip.decompress(
+        (tmp_path / f"out.{format}.gz").read_bytes()).startswith(magic)
+
+
+def test_vector_path_output_error(tmp_path):
+    fig = _sample_figure()
+    FigureCanvasCairo(fig)
+    with pytest.raises(FileNotFoundError):
+        fig.savefig(tmp_path / "missing" / "out.pdf")
+    assert not (tmp_path / "missing").exists()
+
+
+def _sample_figure():
+    fig = Figure(figsize=(2, 1.5), dpi=100)
+    ax = fig.subplots()
+    ax.plot([0, 1, 2], [0, 1, 0], marker="o")
+    ax.imshow(np.arange(16).reshape((4, 4)), extent=(0, 2, 0, 1))
+    ax.set_title("$x^2$")
+    return fig
+
+
+@pytest.mark.parametrize("format, magic", [
+    ("pdf", b"%PDF"),
+    ("ps", b"%!PS"),
+    ("eps", b"%!PS"),
+    ("svg", b"<?xml"),
+    ("svgz", b"\x1f\x8b"),
+    ("png", b"\x89PNG"),
+    ("tiff", b"II*\0"),
+    ("webp", b"RIFF"),
+])
+def test_recording_formats(format, magic):
+    rec = Recording(_sample_figure())
+    buf = BytesIO()
+    rec.savefig(buf, format=format)
+    assert buf.getvalue().startswith(magic)
+
+
+@pytest.mark.parametrize("dpi", [50, 100, 200])
+def test_recording_raster(dpi):
+    fig = _sample_figure()
+    rec = Recording(fig, image_dpi=dpi)
+    buf = BytesIO()
+    rec.savefig(buf, format="rgba", dpi=dpi)
+    img = np.frombuffer(buf.getvalue(), np.uint8).reshape(
+        (round(1.5 * dpi), round(2 * dpi), 4))
+    # Not pixel-identical to direct output (see Recording's docstring), but
+    # close to it.
+    FigureCanvasCairo(fig)
+    direct = BytesIO()
+    fig.savefig(direct, format="rgba", dpi=dpi)
+    direct = np.frombuffer(direct.getvalue(), np.uint8).reshape(img.shape)
+    assert np.abs(img.astype(float) - direct).mean() < 8
+
+
+def _marker_figure(per_marker):
+    fig = Figure(figsize=(2, 2), dpi=72)
+    ax = fig.add_axes([0, 0, 1, 1])
+    ax.set(xlim=(0, 1), ylim=(0, 1))
+    ax.set_axis_off()
+    xys = np.random.RandomState(0).random_sample((2, 50))
+    style = dict(marker="s", markersize=8, mfc=(0, 0, 1, .5), mec="r")
+    if per_marker:  # Single markers are drawn directly at their vertex.
+        for x, y in xys.T:
+            ax.plot(x, y, **style)
+    else:
+        ax.plot(*xys, linestyle="none", **style)
+    return fig
+
+
+def test_vector_markers_match_per_marker_paths():
+    # Rasterize both recordings (drawn as vector output) in the same way.
+    def render(per_marker):
+        buf = BytesIO()
+        Recording(_marker_figure(per_marker)).savefig(
+            buf, format="rgba", dpi=72)
+        return np.frombuffer(buf.getvalue(), np.uint8).reshape((144, 144, 4))
+
+    assert np.abs(render(False).astype(float) - render(True)).mean() < .5
+
+
+def test_vector_markers_are_reused():
+    fig = _marker_figure(False)
+    FigureCanvasCairo(fig)
+    buf = BytesIO()
+    fig.savefig(buf, format="svg")
+    # The marker is defined once, and referenced at each vertex.
+    refs = Counter(re.findall(rb'xlink:href="#([^"]+)"', buf.getvalue()))
+    assert refs and max(refs.values()) >= 50
+
+@pytest.mark.parametrize("format", ["pdf", "ps"])
+@pytest.mark.parametrize("background", [False, True])
+def test_multipage_stats_add_up(format, background):
+    buf = BytesIO()
+    with MultiPage(buf, format, background=background, stats=True) as mp:
+        for _ in range(3):
+            mp.savefig(_sample_figure())
+    assert len(mp.page_stats) == 3
+    assert all(stats.nbytes > 0 for stats in mp.page_stats)
+    assert sum(stats.nbytes for stats in mp.page_stats) == len(buf.getvalue())
+
+
+def test_multipage_background_matches_sequential(monkeypatch):
+    monkeypatch.setenv("SOURCE_DATE_EPOCH", "0")  # Fix the CreationDate.
+
+    def save(background):
+        buf = BytesIO()
+        with MultiPage(buf, "pdf", background=background) as mp:
+            for _ in range(3):
+                mp.savefig(_sample_figure())  # Includes an image.
+        return buf.getvalue()
+
+    assert save(True) == save(False)
+
+
+@pytest.mark.parametrize("shading, shape", [
+    ("flat", (9, 11)),
+    ("gouraud", (10, 12)),
+])
+@pytest.mark.parametrize("threads", [2, 3, 8])
+def test_mesh_bands_match_single_thread(shading, shape, threads):
+    def render():
+        fig = Figure(figsize=(2, 2))
+        x, y = np.meshgrid(np.linspace(0, 1, 12), np.linspace(0, 1, 10))
+        # Skewed, so that the quadmesh does not take the rectilinear path.
+        fig.subplots().pcolormesh(
+            x + .3 * y, y, np.arange(np.prod(shape)).reshape(shape),
+            shading=shading)
+        return _render(fig)
+
+    serial = render()
+    try:
+        mplcairo.set_options(collection_threads=threads)
+        banded = render()
+    finally:
+        mplcairo.set_options(collection_threads=0)
+    assert np.abs(banded.astype(float) - serial).mean() < .5
+
+
+@pytest.mark.parametrize("antialiased", [True, False])
+@pytest.mark.parametrize("edgecolors", ["none", "k"])
+def test_rectilinear_mesh_matches_mesh_pattern(antialiased, edgecolors):
+    # Axes spanning the whole figure, with one data unit per pixel, so that
+    # the (nonuniformly spaced, vertically decreasing) cell edges are
+    # pixel-aligned.
+    xs = np.array([10, 13, 20, 21, 40, 90, 91, 150, 190])
+    ys = np.array([180, 160, 159, 120, 60, 57, 20])
+    c = np.random.RandomState(0).random_sample((len(ys) - 1, len(xs) - 1))
+
+    def render(skew):
+        fig = Figure(figsize=(2, 2), dpi=100)
+        ax = fig.add_axes([0, 0, 1, 1])
+        ax.set(xlim=(0, 200), ylim=(0, 200))
+        ax.set_axis_off()
+        x, y = np.meshgrid(xs, ys)
+        ax.pcolormesh(x + skew * y, y, c, alpha=.8,
+                      antialiased=antialiased, edgecolors=edgecolors)
+        return _render(fig)
+
+    # A negligible skew makes the mesh non-rectilinear, so that it is drawn
+    # as a mesh pattern instead of through the rectilinear fast path.
+    np.testing.assert_allclose(render(0), render(1e-6), atol=1)
+
+def test_batch_render(tmp_path):
+    # Figures of different sizes, to check that outputs are not mixed up.
+    figs = [Figure(figsize=(1 + k, 1)) for k in range(3)]
+    kwargs = {"processes": 2, "savefig_kwargs": {"dpi": 10}}
+    paths = list(batch.render(figs, output_dir=tmp_path, **kwargs))
+    assert paths == [tmp_path / f"{k}.png" for k in range(3)]
+    assert [Image.open(path).size for path in paths] == [
+        (10 * (1 + k), 10) for k in range(3)]
+    pngs = list(batch.render(figs, **kwargs))
+    assert [Image.open(BytesIO(png)).size for png in pngs] == [
+        (10 * (1 + k), 10) for k in range(3)]
@@ -1,3 +1,4 @@
+from io import BytesIO
 import multiprocessing
 import sys
 
@@ -9,7 +10,7 @@ import numpy as np
 
 from matplotlib.backends.backend_agg import FigureCanvasAgg
 import mplcairo
-from mplcairo import _mplcairo, antialias_t
+from mplcairo import _mplcairo, antialias_t, batch
 from mplcairo.base import FigureCanvasCairo
 
 # Import an autouse fixture.
@@ -168,3 +169,39 @@ def test_image(benchmark, canvas_cls, axes, sample_image):
     despine(axes)
     axes.figure.canvas = canvas_cls(axes.figure)
     benchmark(axes.figure.canvas.draw)
+
+
+@pytest.mark.parametrize("canvas_cls", _canvas_classes)
+def test_bars(benchmark, axes, canvas_cls):
+    axes.bar(range(1000), np.random.RandomState(0).random_sample(1000),
+             width=1, edgecolor="none")
+    despine(axes)
+    axes.figure.canvas = canvas_cls(axes.figure)
+    benchmark(axes.figure.canvas.draw)
+
+def _batch_figure():  # Module-level, hence picklable.
+    fig = Figure()
+    ax = fig.subplots()
+    ax.plot(*np.random.RandomState(0).random_sample((2, 10000)))
+    ax.set_title("title")
+    return fig
+
+
+_batch_size = 16
+
+
+@pytest.mark.parametrize("format", ["png", "pdf"])
+def test_batch_serial(benchmark, format):
+    def export():
+        for _ in range(_batch_size):
+            fig = _batch_figure()
+            FigureCanvasCairo(fig)
+            fig.savefig(BytesIO(), format=format)
+    benchmark(export)
+
+
+@pytest.mark.parametrize("format", ["png", "pdf"])
+@pytest.mark.parametrize("processes", [1, multiprocessing.cpu_count()])
+def test_batch(benchmark, format, processes):
+    benchmark(lambda: list(batch.render(
+        [_batch_figure] * _batch_size, format, processes=processes)))